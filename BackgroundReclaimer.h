@@ -0,0 +1,86 @@
+//
+//  BackgroundReclaimer.h
+//  Data Structure - LinkedList
+//
+// A single worker thread that frees detached node chains for clear_async(),
+// so tearing down a big list costs the caller one hand-off instead of one
+// deallocation per node.
+//
+// The worker is started on first use and lives for the rest of the process.
+// Chains still queued when the process exits are not freed.
+//
+
+#ifndef BACKGROUNDRECLAIMER_h
+#define BACKGROUNDRECLAIMER_h
+
+
+class BackgroundReclaimer {
+public:
+	// Queues object, reclaim(object) runs later on the worker thread and must not throw
+	static void post(void* object, void (*reclaim)(void*)) {
+		instance().enqueue({ object, reclaim });
+	}
+
+	// Blocks until everything posted so far has been reclaimed
+	static void drain() {
+		instance().wait_idle();
+	}
+
+private:
+	struct Job {
+		void* object;
+		void (*reclaim)(void*);
+	};
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable idle;
+	std::vector<Job> queue;
+	bool busy = false;
+
+	BackgroundReclaimer() {
+		std::thread{ [this] { run(); } }.detach();
+	}
+
+	static BackgroundReclaimer& instance() {
+		static BackgroundReclaimer* reclaimer = new BackgroundReclaimer;		// never destroyed, the worker is detached
+		return *reclaimer;
+	}
+
+	void enqueue(Job job);
+	void wait_idle();
+	void run();
+};
+
+inline void BackgroundReclaimer::enqueue(Job job) {
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		queue.push_back(job);
+	}
+	wake.notify_one();
+}
+
+inline void BackgroundReclaimer::wait_idle() {
+	std::unique_lock<std::mutex> lock{ mutex };
+	idle.wait(lock, [this] { return queue.empty() && !busy; });
+}
+
+inline void BackgroundReclaimer::run() {
+	std::vector<Job> batch;
+	std::unique_lock<std::mutex> lock{ mutex };
+	for (;;) {
+		wake.wait(lock, [this] { return !queue.empty(); });
+		batch.swap(queue);
+		busy = true;
+		lock.unlock();
+
+		for (const Job& job : batch) job.reclaim(job.object);
+		batch.clear();
+
+		lock.lock();
+		busy = false;
+		if (queue.empty()) idle.notify_all();
+	}
+}
+
+#endif
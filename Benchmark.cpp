@@ -0,0 +1,1733 @@
+//
+//  Benchmark.cpp
+//  Data Structure - LinkedList
+//
+// Micro benchmarks for the list templates, built on Google Benchmark.
+// Run with --benchmark_filter to pick a section, the results are written to
+// benchmark_results.json as well.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <forward_list>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "PoolAllocator.h"
+#include "SingleLinkedList.h"
+#include "DoubleLinkedList.h"
+#include "UnrolledLinkedList.h"
+#include "ConcurrentSingleLinkedList.h"
+#include "IntrusiveSingleLinkedList.h"
+#include "IntrusiveDoubleLinkedList.h"
+#include "LinkedQueue.h"
+#include "OrderedLinkedList.h"
+#include "LinkedHashMap.h"
+#include "PersistentList.h"
+#include "ParallelAlgorithms.h"
+#include "ListSerialization.h"
+#include "CompactDoubleLinkedList.h"
+#include "IndexLinkedList.h"
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Single Linked List //////////////////////
+///////////////////////////////////////////////////////////////////////
+
+template <class List>
+static void BM_SingleLinkedList_PopBackDrain(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		List list;
+		for (int i = 0; i < n; ++i) list.push_back(i);
+		state.ResumeTiming();
+
+		while (!list.empty()) list.pop_back();
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetComplexityN(n);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+// Without back links every pop walks from head, so keep the sizes small
+BENCHMARK_TEMPLATE(BM_SingleLinkedList_PopBackDrain, SingleLinkedList<int>)->RangeMultiplier(4)->Range(256, 16384)->Complexity(benchmark::oNSquared);
+BENCHMARK_TEMPLATE(BM_SingleLinkedList_PopBackDrain, SingleLinkedList<int, std::allocator<int>, true>)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Double Linked List //////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Drains the whole list from the back, the way an LRU evicts its tail
+static void BM_DoubleLinkedList_PopBackDrain(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		DoubleLinkedList<int> list;
+		for (int i = 0; i < n; ++i) list.push_back(i);
+		state.ResumeTiming();
+
+		while (!list.empty()) list.pop_back();
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetComplexityN(n);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DoubleLinkedList_PopBackDrain)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+
+// Erases through an iterator to the last element instead of pop_back
+static void BM_DoubleLinkedList_EraseBackDrain(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		DoubleLinkedList<int> list;
+		for (int i = 0; i < n; ++i) list.push_back(i);
+		state.ResumeTiming();
+
+		while (!list.empty()) list.erase(std::prev(list.cend()));
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetComplexityN(n);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DoubleLinkedList_EraseBackDrain)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oN);
+
+// Moves every element of a staging list to an active list one at a time
+static void BM_DoubleLinkedList_TransferPopPush(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		DoubleLinkedList<int> staging, active;
+		for (int i = 0; i < n; ++i) staging.push_back(i);
+		state.ResumeTiming();
+
+		while (!staging.empty()) {
+			active.push_back(std::move(*staging.begin()));
+			staging.pop_front();
+		}
+		benchmark::DoNotOptimize(active);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DoubleLinkedList_TransferPopPush)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_DoubleLinkedList_TransferSplice(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		DoubleLinkedList<int> staging, active;
+		for (int i = 0; i < n; ++i) staging.push_back(i);
+		state.ResumeTiming();
+
+		while (!staging.empty()) active.splice(active.cend(), staging, staging.cbegin());
+		benchmark::DoNotOptimize(active);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DoubleLinkedList_TransferSplice)->RangeMultiplier(10)->Range(1000, 1000000);
+
+// The whole list back and forth, constant whatever the length
+static void BM_DoubleLinkedList_TransferSpliceAll(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	DoubleLinkedList<int> staging, active;
+	for (int i = 0; i < n; ++i) staging.push_back(i);
+
+	for (auto _ : state) {
+		active.splice(active.cend(), staging);
+		staging.splice(staging.cend(), active);
+		benchmark::DoNotOptimize(staging);
+	}
+}
+BENCHMARK(BM_DoubleLinkedList_TransferSpliceAll)->RangeMultiplier(10)->Range(1000, 1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Unrolled Linked List ////////////////////
+///////////////////////////////////////////////////////////////////////
+
+template <class List>
+static List make_filled(int n) {
+	List list;
+	for (int i = 0; i < n; ++i) list.push_back(i);
+	return list;
+}
+
+// Looks for a value that is not there, so every element gets visited
+template <class List>
+static void BM_Traverse_Search(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.search(-1));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Traverse_Search, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Traverse_Search, UnrolledLinkedList<int, 16>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Traverse_Search, UnrolledLinkedList<int, 64>)->RangeMultiplier(10)->Range(1000, 1000000);
+
+template <class List>
+static void BM_Insert_PushBack(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		List list = make_filled<List>(n);
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Insert_PushBack, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Insert_PushBack, UnrolledLinkedList<int, 16>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Insert_PushBack, UnrolledLinkedList<int, 64>)->RangeMultiplier(10)->Range(1000, 1000000);
+
+// Inserts after every element of a list, doubling its length
+template <class List>
+static void BM_Insert_AfterEach(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		List list = make_filled<List>(n);
+		state.ResumeTiming();
+
+		for (auto pos = list.cbegin(); pos != list.cend(); ++pos) {
+			pos = list.insert_after(pos, 0);
+		}
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Insert_AfterEach, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Insert_AfterEach, UnrolledLinkedList<int, 16>)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Insert_AfterEach, UnrolledLinkedList<int, 64>)->RangeMultiplier(10)->Range(1000, 100000);
+
+// Erases every other element, halving the list
+template <class List>
+static void BM_Erase_AfterEach(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		List list = make_filled<List>(n);
+		state.ResumeTiming();
+
+		for (auto pos = list.cbegin(); pos != list.cend(); ) {
+			pos = list.erase_after(pos);
+		}
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetItemsProcessed(state.iterations() * n / 2);
+}
+BENCHMARK_TEMPLATE(BM_Erase_AfterEach, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Erase_AfterEach, UnrolledLinkedList<int, 16>)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Erase_AfterEach, UnrolledLinkedList<int, 64>)->RangeMultiplier(10)->Range(1000, 100000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Construction ////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+template <class List>
+static void BM_CopyConstruct(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	const List source = make_filled<List>(n);
+	for (auto _ : state) {
+		List copy{ source };
+		benchmark::DoNotOptimize(copy);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_CopyConstruct, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, std::list<int>)->RangeMultiplier(10)->Range(1000, 10000000);
+
+// The copy as it was done before, one push_back per element
+template <class List>
+static void BM_CopyPushBack(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	const List source = make_filled<List>(n);
+	for (auto _ : state) {
+		List copy;
+		for (const auto& value : source) copy.push_back(value);
+		benchmark::DoNotOptimize(copy);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_CopyPushBack, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_CopyPushBack, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 10000000);
+
+template <class List>
+static void BM_RangeConstruct(benchmark::State& state) {
+	std::vector<int> values(static_cast<std::size_t>(state.range(0)));
+	std::iota(values.begin(), values.end(), 0);
+	for (auto _ : state) {
+		List list(values.begin(), values.end());
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_RangeConstruct, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_RangeConstruct, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_RangeConstruct, std::list<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+
+// assign() over a list of the same length reuses every node
+template <class List>
+static void BM_Assign(benchmark::State& state) {
+	std::vector<int> values(static_cast<std::size_t>(state.range(0)));
+	std::iota(values.begin(), values.end(), 0);
+	List list(values.begin(), values.end());
+	for (auto _ : state) {
+		list.assign(values.begin(), values.end());
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Assign, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Assign, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Assign, std::list<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+
+///////////////////////////////////////////////////////////////////////
+/////////////////////////////// Teardown //////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Only the teardown is timed, building the list each round is not
+template <class List, class Teardown>
+static void run_teardown(benchmark::State& state, Teardown teardown) {
+	const auto n = static_cast<std::size_t>(state.range(0));
+	for (auto _ : state) {
+		List list(n, 1);
+		const auto start = std::chrono::steady_clock::now();
+		teardown(list);
+		const auto stop = std::chrono::steady_clock::now();
+		state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+		BackgroundReclaimer::drain();		// clear_async() finishes before the next round
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The way clear() used to work
+template <class List>
+static void BM_Teardown_PopFront(benchmark::State& state) {
+	run_teardown<List>(state, [](List& list) { while (!list.empty()) list.pop_front(); });
+}
+BENCHMARK_TEMPLATE(BM_Teardown_PopFront, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Teardown_PopFront, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Teardown_PopFront, DoubleLinkedList<int, PoolAllocator<int>>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+
+template <class List>
+static void BM_Teardown_Clear(benchmark::State& state) {
+	run_teardown<List>(state, [](List& list) { list.clear(); });
+}
+BENCHMARK_TEMPLATE(BM_Teardown_Clear, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Teardown_Clear, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Teardown_Clear, DoubleLinkedList<int, PoolAllocator<int>>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Teardown_Clear, std::list<int>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+
+// Only the caller's share, the nodes are freed on the reclaimer thread
+template <class List>
+static void BM_Teardown_ClearAsync(benchmark::State& state) {
+	run_teardown<List>(state, [](List& list) { list.clear_async(); });
+}
+BENCHMARK_TEMPLATE(BM_Teardown_ClearAsync, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Teardown_ClearAsync, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_Teardown_ClearAsync, DoubleLinkedList<int, PoolAllocator<int>>)->RangeMultiplier(10)->Range(1000000, 10000000)->UseManualTime();
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// SIMD search /////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+template <class T>
+static void BM_Block_StdFind(benchmark::State& state) {
+	const std::vector<T> block(static_cast<std::size_t>(state.range(0)), T(1));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(std::find(block.data(), block.data() + block.size(), T(0)));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Block_StdFind, int)->Arg(16)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Block_StdFind, float)->Arg(16)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Block_StdFind, double)->Arg(16)->Arg(64)->Arg(4096);
+
+template <class T>
+static void BM_Block_SimdFind(benchmark::State& state) {
+	const std::vector<T> block(static_cast<std::size_t>(state.range(0)), T(1));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(simd::find(block.data(), block.data() + block.size(), T(0)));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Block_SimdFind, int)->Arg(16)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Block_SimdFind, float)->Arg(16)->Arg(64)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_Block_SimdFind, double)->Arg(16)->Arg(64)->Arg(4096);
+
+// find_if takes the scalar path through the same blocks that search() vectorizes
+template <class List>
+static void BM_Unrolled_ScalarSearch(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.find_if([](int x) { return x == -1; }));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Unrolled_ScalarSearch, UnrolledLinkedList<int, 16>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Unrolled_ScalarSearch, UnrolledLinkedList<int, 64>)->RangeMultiplier(10)->Range(1000, 1000000);
+
+template <class List>
+static void BM_Count(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.count(7));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Count, SingleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Count, UnrolledLinkedList<int, 64>)->Arg(1000000);
+
+// 16 absent keys, one search() per key against one contains_any() pass
+template <class List>
+static void BM_ContainsAny_RepeatedSearch(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	std::vector<int> keys(16);
+	std::iota(keys.begin(), keys.end(), -16);
+	for (auto _ : state) {
+		bool found = false;
+		for (int key : keys) found = found || list.search(key);
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_ContainsAny_RepeatedSearch, SingleLinkedList<int>)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_ContainsAny_RepeatedSearch, UnrolledLinkedList<int, 64>)->Arg(100000);
+
+template <class List>
+static void BM_ContainsAny(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	std::vector<int> keys(16);
+	std::iota(keys.begin(), keys.end(), -16);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.contains_any(keys.begin(), keys.end()));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_ContainsAny, SingleLinkedList<int>)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_ContainsAny, UnrolledLinkedList<int, 64>)->Arg(100000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Sorting /////////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+static std::vector<int> shuffled_values(int n) {
+	std::vector<int> values(static_cast<std::size_t>(n));
+	std::iota(values.begin(), values.end(), 0);
+	std::shuffle(values.begin(), values.end(), std::mt19937{ 42 });
+	return values;
+}
+
+template <class List>
+static void BM_Sort(benchmark::State& state) {
+	const std::vector<int> values = shuffled_values(static_cast<int>(state.range(0)));
+	for (auto _ : state) {
+		state.PauseTiming();
+		List list;
+		for (int value : values) list.push_back(value);
+		state.ResumeTiming();
+
+		list.sort();
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Sort, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oNLogN);
+BENCHMARK_TEMPLATE(BM_Sort, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oNLogN);
+BENCHMARK_TEMPLATE(BM_Sort, std::list<int>)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oNLogN);
+
+// What callers did before sort(): copy out, sort the copy and build a new list
+static void BM_Sort_ViaVector(benchmark::State& state) {
+	const std::vector<int> values = shuffled_values(static_cast<int>(state.range(0)));
+	for (auto _ : state) {
+		state.PauseTiming();
+		SingleLinkedList<int> list;
+		for (int value : values) list.push_back(value);
+		state.ResumeTiming();
+
+		std::vector<int> copy(list.begin(), list.end());
+		std::sort(copy.begin(), copy.end());
+		SingleLinkedList<int> sorted;
+		for (int value : copy) sorted.push_back(value);
+		list = std::move(sorted);
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetComplexityN(state.range(0));
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sort_ViaVector)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oNLogN);
+
+template <class List>
+static void BM_Merge(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	for (auto _ : state) {
+		state.PauseTiming();
+		List evens, odds;
+		for (int i = 0; i < n; i += 2) {
+			evens.push_back(i);
+			odds.push_back(i + 1);
+		}
+		state.ResumeTiming();
+
+		evens.merge(odds);
+		benchmark::DoNotOptimize(evens);
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Merge, SingleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Merge, DoubleLinkedList<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Merge, std::list<int>)->RangeMultiplier(10)->Range(1000, 1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Intrusive Linked List ///////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Stands in for a connection or session object that already lives in an arena
+struct Session {
+	long id = 0;
+	char payload[48] = {};
+	SingleLinkHook<Session> queue_hook;
+	DoubleLinkHook<Session> active_hook;
+};
+
+// Every session goes in at the back and leaves from the middle, the way idle
+// connections get picked off. The owning lists copy each session into a node.
+static void BM_Sessions_DoubleLinkedList(benchmark::State& state) {
+	std::vector<Session> arena(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		DoubleLinkedList<Session> active;
+		for (const Session& session : arena) active.push_back(session);
+		for (auto pos = active.cbegin(); pos != active.cend(); ) {
+			pos = active.erase(pos);
+			if (pos != active.cend()) ++pos;
+		}
+		benchmark::DoNotOptimize(active);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sessions_DoubleLinkedList)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_Sessions_IntrusiveDoubleLinkedList(benchmark::State& state) {
+	std::vector<Session> arena(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		IntrusiveDoubleLinkedList<Session, &Session::active_hook> active;
+		for (Session& session : arena) active.push_back(session);
+		for (std::size_t i = 0; i < arena.size(); i += 2) active.erase(arena[i]);
+		benchmark::DoNotOptimize(active);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sessions_IntrusiveDoubleLinkedList)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_Sessions_SingleLinkedList(benchmark::State& state) {
+	std::vector<Session> arena(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		SingleLinkedList<Session> queue;
+		for (const Session& session : arena) queue.push_back(session);
+		while (!queue.empty()) queue.pop_front();
+		benchmark::DoNotOptimize(queue);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sessions_SingleLinkedList)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_Sessions_IntrusiveSingleLinkedList(benchmark::State& state) {
+	std::vector<Session> arena(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		IntrusiveSingleLinkedList<Session, &Session::queue_hook> queue;
+		for (Session& session : arena) queue.push_back(session);
+		while (!queue.empty()) queue.pop_front();
+		benchmark::DoNotOptimize(queue);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sessions_IntrusiveSingleLinkedList)->RangeMultiplier(10)->Range(1000, 1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Concurrent Linked List //////////////////
+///////////////////////////////////////////////////////////////////////
+
+// The baseline: a SingleLinkedList behind one mutex
+class LockedSingleLinkedList {
+	std::mutex mutex;
+	SingleLinkedList<long> list;
+
+public:
+	void push_front(long x) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		list.push_front(x);
+	}
+
+	bool erase(long x) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		for (auto pos = list.cbefore_begin(); std::next(pos) != list.cend(); ++pos) {
+			if (*std::next(pos) == x) {
+				list.erase_after(pos);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool search(long x) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		return list.search(x);
+	}
+};
+
+// 80% search, 10% push and 10% erase against a list that stays near 1024 elements
+template <class List>
+static void BM_Concurrent_Mixed(benchmark::State& state) {
+	static List* list = nullptr;
+	constexpr long prefill = 1024;
+	if (state.thread_index() == 0) {
+		list = new List;
+		for (long i = 0; i < prefill; ++i) list->push_front(i);
+	}
+
+	// Every thread pushes and erases its own keys, so erase always finds its key
+	long next_key = prefill + long(state.thread_index()) * (long(1) << 40);
+	long oldest_key = next_key;
+	unsigned op = 0;
+	for (auto _ : state) {
+		switch (op++ % 10) {
+		case 0:
+			list->push_front(next_key++);
+			break;
+		case 1:
+			benchmark::DoNotOptimize(list->erase(oldest_key++));
+			break;
+		default:
+			benchmark::DoNotOptimize(list->search(long(op % prefill)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0) {
+		delete list;
+		list = nullptr;
+	}
+}
+BENCHMARK_TEMPLATE(BM_Concurrent_Mixed, LockedSingleLinkedList)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Concurrent_Mixed, ConcurrentSingleLinkedList<long>)->ThreadRange(1, 16)->UseRealTime();
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Linked Queue ////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// The baseline: a DoubleLinkedList work queue behind a mutex
+class LockedQueue {
+	std::mutex mutex;
+	DoubleLinkedList<long> list;
+
+public:
+	void push(long x) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		list.push_back(x);
+	}
+
+	template <class InputIt>
+	void push_range(InputIt first, InputIt last) {
+		std::lock_guard<std::mutex> lock{ mutex };
+		list.append_range(first, last);
+	}
+
+	// Takes everything queued so far under one lock
+	template <class OutputIt>
+	std::size_t pop_bulk(OutputIt out) {
+		DoubleLinkedList<long> taken;
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			taken.splice(taken.cend(), list);
+		}
+		for (long x : taken) *out++ = x;
+		return taken.size();
+	}
+};
+
+// range(0) producers hand 2^17 elements in all to the benchmark thread, range(1) at a time
+template <class Queue>
+static void BM_Queue_Handoff(benchmark::State& state) {
+	const auto producers = static_cast<int>(state.range(0));
+	const auto batch = static_cast<std::size_t>(state.range(1));
+	const std::size_t per_producer = (std::size_t(1) << 17) / static_cast<std::size_t>(producers);
+	std::vector<long> received;
+	received.reserve(per_producer * static_cast<std::size_t>(producers));
+
+	for (auto _ : state) {
+		Queue queue;
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; ++p) {
+			threads.emplace_back([&queue, batch, per_producer] {
+				std::vector<long> values(batch);
+				for (std::size_t sent = 0; sent < per_producer; sent += batch) {
+					if (batch == 1) queue.push(long(sent));
+					else queue.push_range(values.begin(), values.end());
+				}
+			});
+		}
+
+		received.clear();
+		while (received.size() < per_producer * static_cast<std::size_t>(producers)) {
+			if (queue.pop_bulk(std::back_inserter(received)) == 0) std::this_thread::yield();
+		}
+		for (std::thread& thread : threads) thread.join();
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(received.size()));
+}
+BENCHMARK_TEMPLATE(BM_Queue_Handoff, LockedQueue)->ArgsProduct({ { 1, 2, 4 }, { 1, 64 } })->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Queue_Handoff, LinkedQueue<long, QueueMode::SingleProducer>)->ArgsProduct({ { 1 }, { 1, 64 } })->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Queue_Handoff, LinkedQueue<long, QueueMode::MultiProducer>)->ArgsProduct({ { 1, 2, 4 }, { 1, 64 } })->UseRealTime();
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Ordered Linked List /////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// 1M even keys, looking up random ones of them
+static void BM_Ordered_LinearSearch(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	SingleLinkedList<int> list;
+	for (int i = 0; i < n; ++i) list.push_back(2 * i);
+	std::mt19937 rng{ 7 };
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.search(2 * static_cast<int>(rng() % unsigned(n))));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Ordered_LinearSearch)->Arg(1000000);
+
+static void BM_Ordered_Find(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	OrderedLinkedList<int> list;
+	for (int i = 0; i < n; ++i) list.insert_sorted(2 * i);
+	std::mt19937 rng{ 7 };
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.find(2 * static_cast<int>(rng() % unsigned(n))));
+	}
+	state.SetItemsProcessed(state.iterations());
+	state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Ordered_Find)->RangeMultiplier(10)->Range(1000, 1000000)->Complexity(benchmark::oLogN);
+
+// Odd keys land between the existing ones
+static void BM_Ordered_LowerBound(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	OrderedLinkedList<int> list;
+	for (int i = 0; i < n; ++i) list.insert_sorted(2 * i);
+	std::mt19937 rng{ 7 };
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.lower_bound(2 * static_cast<int>(rng() % unsigned(n)) + 1));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Ordered_LowerBound)->Arg(1000000);
+
+// Builds the list from random keys, one insert_sorted each
+static void BM_Ordered_InsertSorted(benchmark::State& state) {
+	const auto n = static_cast<std::size_t>(state.range(0));
+	std::vector<int> keys(n);
+	std::mt19937 rng{ 7 };
+	for (int& key : keys) key = static_cast<int>(rng());
+	for (auto _ : state) {
+		OrderedLinkedList<int> list;
+		for (int key : keys) list.insert_sorted(key);
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Ordered_InsertSorted)->RangeMultiplier(10)->Range(1000, 1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Linked Hash Map /////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// The baseline LRU cache: a DoubleLinkedList in recency order plus an
+// unordered_map from each key to its list node, two allocations per entry
+class PairedLru {
+	using Entry = std::pair<int, long>;
+	DoubleLinkedList<Entry> order;
+	std::unordered_map<int, DoubleLinkedList<Entry>::iterator> index;
+	std::size_t capacity;
+
+public:
+	explicit PairedLru(std::size_t capacity) : capacity{ capacity } { index.reserve(capacity); }
+
+	long get(int key) {
+		auto found = index.find(key);
+		if (found != index.end()) {
+			order.splice(order.cbegin(), order, found->second);
+			return found->second->second;
+		}
+		if (index.size() == capacity) {
+			index.erase(std::prev(order.end())->first);
+			order.pop_back();
+		}
+		order.emplace_front(key, long(key));
+		index.emplace(key, order.begin());
+		return key;
+	}
+
+	void erase(int key) {
+		auto found = index.find(key);
+		if (found == index.end()) return;
+		order.erase(found->second);
+		index.erase(found);
+	}
+};
+
+class LinkedLru {
+	LinkedHashMap<int, long, std::hash<int>, std::equal_to<int>, LinkOrder::Access> map;
+
+public:
+	explicit LinkedLru(std::size_t capacity) : map(capacity) { map.set_capacity(capacity); }
+
+	long get(int key) { return map.try_emplace(key, long(key)).first->second; }
+	void erase(int key) { map.erase(key); }
+};
+
+// A full cache of range(0) entries, looking up keys from twice as many, so half the lookups miss and evict
+template <class Cache>
+static void BM_Lru_Get(benchmark::State& state) {
+	const auto n = static_cast<std::size_t>(state.range(0));
+	Cache cache{ n };
+	for (std::size_t i = 0; i < n; ++i) cache.get(static_cast<int>(i));
+	std::mt19937 rng{ 7 };
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(cache.get(static_cast<int>(rng() % (2 * n))));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Lru_Get, PairedLru)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Lru_Get, LinkedLru)->RangeMultiplier(10)->Range(1000, 1000000);
+
+// Erases a random resident key and brings it back, every lookup hits
+template <class Cache>
+static void BM_Lru_EraseInsert(benchmark::State& state) {
+	const auto n = static_cast<std::size_t>(state.range(0));
+	Cache cache{ n };
+	for (std::size_t i = 0; i < n; ++i) cache.get(static_cast<int>(i));
+	std::mt19937 rng{ 7 };
+	for (auto _ : state) {
+		const int key = static_cast<int>(rng() % n);
+		cache.erase(key);
+		benchmark::DoNotOptimize(cache.get(key));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Lru_EraseInsert, PairedLru)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Lru_EraseInsert, LinkedLru)->RangeMultiplier(10)->Range(1000, 1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Persistent List /////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// A reader taking a snapshot of a range(0) element list
+template <class List>
+static void BM_Snapshot(benchmark::State& state) {
+	std::vector<int> values(static_cast<std::size_t>(state.range(0)));
+	std::iota(values.begin(), values.end(), 0);
+	const List list(values.begin(), values.end());
+	for (auto _ : state) {
+		List snapshot{ list };
+		benchmark::DoNotOptimize(snapshot);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Snapshot, SingleLinkedList<int>)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK_TEMPLATE(BM_Snapshot, PersistentList<int>)->RangeMultiplier(10)->Range(10, 100000);
+
+// A writer publishing a new version with one more element while the old one stays readable
+static void BM_Snapshot_UpdateCopy(benchmark::State& state) {
+	std::vector<int> values(static_cast<std::size_t>(state.range(0)));
+	std::iota(values.begin(), values.end(), 0);
+	const SingleLinkedList<int> published(values.begin(), values.end());
+	for (auto _ : state) {
+		SingleLinkedList<int> next{ published };
+		next.push_front(-1);
+		benchmark::DoNotOptimize(next);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Snapshot_UpdateCopy)->RangeMultiplier(10)->Range(10, 100000);
+
+static void BM_Snapshot_UpdatePersistent(benchmark::State& state) {
+	std::vector<int> values(static_cast<std::size_t>(state.range(0)));
+	std::iota(values.begin(), values.end(), 0);
+	const PersistentList<int> published(values.begin(), values.end());
+	for (auto _ : state) {
+		PersistentList<int> next = published.push_front(-1);
+		benchmark::DoNotOptimize(next);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Snapshot_UpdatePersistent)->RangeMultiplier(10)->Range(10, 100000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Parallel Algorithms /////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Scaling over a 2^20 element list, range(0) is the number of threads taking
+// part, the pool's workers plus the benchmark thread. Counts above the
+// machine's core count only measure oversubscription.
+
+static void ParallelThreadCounts(benchmark::internal::Benchmark* b) {
+	for (int threads = 1; threads <= 64; threads *= 2) b->Arg(threads);
+	b->UseRealTime();
+}
+
+// A few rounds of xorshift-multiply, enough work per element to be compute bound
+static std::uint64_t mix(std::uint64_t x) {
+	for (int round = 0; round < 8; ++round) {
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdull;
+	}
+	return x;
+}
+
+static SingleLinkedList<std::uint64_t> make_parallel_list() {
+	SingleLinkedList<std::uint64_t> list;
+	for (std::uint64_t i = 0; i < (1u << 20); ++i) list.push_back(i);
+	return list;
+}
+
+static void BM_Parallel_ForEach(benchmark::State& state) {
+	WorkStealingPool pool{ static_cast<unsigned>(state.range(0) - 1) };
+	auto list = make_parallel_list();
+	for (auto _ : state) {
+		parallel::for_each(list, [](std::uint64_t& x) { x = mix(x); }, pool);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_ForEach)->Apply(ParallelThreadCounts);
+
+static void BM_Parallel_Transform(benchmark::State& state) {
+	WorkStealingPool pool{ static_cast<unsigned>(state.range(0) - 1) };
+	auto list = make_parallel_list();
+	for (auto _ : state) {
+		parallel::transform(list, [](std::uint64_t x) { return mix(x); }, pool);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_Transform)->Apply(ParallelThreadCounts);
+
+// A plain sum is bound by the pointer chase, the partition walk costs about as much as the sum itself
+static void BM_Parallel_Reduce(benchmark::State& state) {
+	WorkStealingPool pool{ static_cast<unsigned>(state.range(0) - 1) };
+	const auto list = make_parallel_list();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(parallel::reduce(list, std::uint64_t(0), std::plus<>(), pool));
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_Reduce)->Apply(ParallelThreadCounts);
+
+// The same sum with the partition kept from one run to the next
+static void BM_Parallel_ReducePartitioned(benchmark::State& state) {
+	WorkStealingPool pool{ static_cast<unsigned>(state.range(0) - 1) };
+	const auto list = make_parallel_list();
+	const auto part = make_partition(list, 4 * pool.concurrency());
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(parallel::reduce(part, std::uint64_t(0), std::plus<>(), pool));
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_ReducePartitioned)->Apply(ParallelThreadCounts);
+
+static void BM_Parallel_CountIf(benchmark::State& state) {
+	WorkStealingPool pool{ static_cast<unsigned>(state.range(0) - 1) };
+	const auto list = make_parallel_list();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(parallel::count_if(list, [](std::uint64_t x) { return mix(x) % 3 == 0; }, pool));
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_CountIf)->Apply(ParallelThreadCounts);
+
+// The only match is the last element
+static void BM_Parallel_FindIf(benchmark::State& state) {
+	WorkStealingPool pool{ static_cast<unsigned>(state.range(0) - 1) };
+	auto list = make_parallel_list();
+	const std::uint64_t target = mix(list.size() - 1);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(parallel::find_if(list, [target](std::uint64_t x) { return mix(x) == target; }, pool));
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_FindIf)->Apply(ParallelThreadCounts);
+
+// Single threaded baselines with the standard algorithms
+static void BM_Parallel_SequentialCountIf(benchmark::State& state) {
+	const auto list = make_parallel_list();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(std::count_if(list.begin(), list.end(), [](std::uint64_t x) { return mix(x) % 3 == 0; }));
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_SequentialCountIf);
+
+static void BM_Parallel_SequentialReduce(benchmark::State& state) {
+	const auto list = make_parallel_list();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(std::accumulate(list.begin(), list.end(), std::uint64_t(0)));
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(list.size()));
+}
+BENCHMARK(BM_Parallel_SequentialReduce);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Serialization ///////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Checkpointing and restoring range(0) ints, as operator<< text and as the binary format
+static SingleLinkedList<int> make_checkpoint_list(std::size_t n) {
+	SingleLinkedList<int> list;
+	std::mt19937 rng{ 7 };
+	for (std::size_t i = 0; i < n; ++i) list.push_back(static_cast<int>(rng()));
+	return list;
+}
+
+static void BM_Checkpoint_Text(benchmark::State& state) {
+	auto list = make_checkpoint_list(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		std::ostringstream out;
+		out << list;
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_Checkpoint_Text)->Arg(10000)->Arg(1000000);
+
+static void BM_Checkpoint_Serialize(benchmark::State& state) {
+	const auto list = make_checkpoint_list(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		std::ostringstream out;
+		serialize(out, list);
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_Checkpoint_Serialize)->Arg(10000)->Arg(1000000);
+
+// The restored lists take their nodes from the pool, so the allocator keeps up with the reads
+using RestoredList = SingleLinkedList<int, PoolAllocator<int>>;
+
+static void BM_Restore_Text(benchmark::State& state) {
+	auto source = make_checkpoint_list(static_cast<std::size_t>(state.range(0)));
+	std::ostringstream out;
+	out << source;
+	const std::string text = out.str();
+	for (auto _ : state) {
+		std::istringstream in{ text };
+		RestoredList list;
+		for (int x; in >> x; ) list.push_back(x);
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_Restore_Text)->Arg(10000)->Arg(1000000);
+
+static void BM_Restore_Deserialize(benchmark::State& state) {
+	std::ostringstream out;
+	serialize(out, make_checkpoint_list(static_cast<std::size_t>(state.range(0))));
+	const std::string bytes = out.str();
+	for (auto _ : state) {
+		std::istringstream in{ bytes };
+		RestoredList list;
+		deserialize(in, list);
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_Restore_Deserialize)->Arg(10000)->Arg(1000000);
+
+// From a file in the page cache
+static void BM_Restore_LoadMapped(benchmark::State& state) {
+	const char* path = "benchmark_checkpoint.bin";
+	serialize(path, make_checkpoint_list(static_cast<std::size_t>(state.range(0))));
+	for (auto _ : state) {
+		RestoredList list;
+		load_mapped(path, list);
+		benchmark::DoNotOptimize(list);
+	}
+	std::remove(path);
+	state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_Restore_LoadMapped)->Arg(10000)->Arg(1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Compact Double Linked List //////////////
+///////////////////////////////////////////////////////////////////////
+
+// Counts the bytes a container asks its allocator for. malloc adds its own
+// header on top, which costs the node per allocation lists more than the
+// compact lists' 1024 node blocks.
+static std::size_t allocated_bytes = 0;
+
+template <class T>
+struct CountingAllocator {
+	using value_type = T;
+
+	CountingAllocator() = default;
+	template <class U>
+	CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+	T* allocate(std::size_t n) {
+		allocated_bytes += n * sizeof(T);
+		return std::allocator<T>().allocate(n);
+	}
+	void deallocate(T* p, std::size_t n) noexcept {
+		allocated_bytes -= n * sizeof(T);
+		std::allocator<T>().deallocate(p, n);
+	}
+
+	template <class U>
+	bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+	template <class U>
+	bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+// Builds range(0) ints with push_back and reports what they cost per element
+template <class List>
+static void BM_Compact_Build(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	double bytes = 0;
+	for (auto _ : state) {
+		const std::size_t before = allocated_bytes;
+		List list;
+		for (int i = 0; i < n; ++i) list.push_back(i);
+		bytes = double(allocated_bytes - before + sizeof(List));
+		benchmark::DoNotOptimize(list);
+	}
+	state.counters["bytes_per_element"] = bytes / double(n);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Compact_Build, std::list<int, CountingAllocator<int>>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Compact_Build, DoubleLinkedList<int, CountingAllocator<int>>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Compact_Build, CompactDoubleLinkedList<int, false, CountingAllocator<int>>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Compact_Build, CompactDoubleLinkedList<int, true, CountingAllocator<int>>)->Arg(1000000);
+
+// Forward and backward sums over a list built with push_back
+template <class List>
+static void BM_Compact_Traverse(benchmark::State& state) {
+	List list;
+	for (int i = 0; i < state.range(0); ++i) list.push_back(i);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(std::accumulate(list.begin(), list.end(), 0L));
+		benchmark::DoNotOptimize(std::accumulate(list.rbegin(), list.rend(), 0L));
+	}
+	state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Compact_Traverse, std::list<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Compact_Traverse, DoubleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Compact_Traverse, CompactDoubleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Compact_Traverse, CompactDoubleLinkedList<int, true>)->Arg(1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Index Linked List ///////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// n elements, half of which have been erased from the front and inserted
+// again in the middle, so list order no longer follows allocation order
+template <class List>
+static List make_churned(int n) {
+	List list = make_filled<List>(n);
+	auto middle = list.begin();
+	std::advance(middle, n / 2);
+	for (int i = 0; i < n / 2; ++i) {
+		list.erase(list.begin());
+		list.insert(middle, n + i);
+	}
+	return list;
+}
+
+template <class List, bool Compacted = false>
+static void BM_Index_Search(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_churned<List>(n);
+	if constexpr (Compacted) list.compact();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.search(-1));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Index_Search, DoubleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Index_Search, IndexLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Index_Search, IndexLinkedList<int>, true)->Arg(1000000);
+
+template <class List, bool Compacted = false>
+static void BM_Index_Count(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_churned<List>(n);
+	if constexpr (Compacted) list.compact();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.count(7));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Index_Count, DoubleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Index_Count, IndexLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Index_Count, IndexLinkedList<int>, true)->Arg(1000000);
+
+// Follows the links, so the index list only gets dense access after compact()
+template <class List, bool Compacted = false>
+static void BM_Index_Traverse(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_churned<List>(n);
+	if constexpr (Compacted) list.compact();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(std::accumulate(list.begin(), list.end(), 0L));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Index_Traverse, DoubleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Index_Traverse, IndexLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Index_Traverse, IndexLinkedList<int>, true)->Arg(1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Relayout ////////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Sorting random values relinks the nodes without moving them, which leaves
+// list order and memory order as far apart as a long run of inserts and erases
+template <class List>
+static List make_scattered(int n) {
+	std::mt19937 rng(42);
+	List list;
+	for (int i = 0; i < n; ++i) list.push_back(static_cast<int>(rng()));
+	list.sort();
+	return list;
+}
+
+template <class List, bool Relaid = false>
+static void BM_Relayout_Search(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_scattered<List>(n);
+	if constexpr (Relaid) list.relayout();
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.search(-1));
+	}
+	state.counters["scattered_links"] = list.scattered_link_fraction();
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Relayout_Search, SingleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Relayout_Search, SingleLinkedList<int>, true)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Relayout_Search, SingleLinkedList<int, PoolAllocator<int>>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_Relayout_Search, SingleLinkedList<int, PoolAllocator<int>>, true)->Arg(1000000);
+
+// One full pass over a scattered list, done in steps of range(1) nodes
+template <class List>
+static void BM_Relayout_Pass(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	const auto step = static_cast<std::size_t>(state.range(1));
+	for (auto _ : state) {
+		state.PauseTiming();
+		List list = make_scattered<List>(n);
+		state.ResumeTiming();
+		for (auto at = list.relayout_after(list.cbefore_begin(), step); at != list.end(); at = list.relayout_after(at, step)) {}
+		state.PauseTiming();
+		list.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_Relayout_Pass, SingleLinkedList<int>)->Args({ 1000000, 1000000 })->Args({ 1000000, 1024 })->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Relayout_Pass, SingleLinkedList<int, PoolAllocator<int>>)->Args({ 1000000, 1000000 })->Args({ 1000000, 1024 })->Unit(benchmark::kMillisecond);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Prefetching /////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Scattered lists of 2^24 elements, a few hundred megabytes of nodes, so
+// nearly every hop misses the last level cache. The plain variants walk the
+// public iterators the way search() and operator<< used to.
+constexpr int prefetch_elements = 1 << 24;
+
+template <class List>
+static void BM_Prefetch_SearchPlain(benchmark::State& state) {
+	List list = make_scattered<List>(prefetch_elements);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(std::find(list.begin(), list.end(), -1) != list.end());
+	}
+	state.SetItemsProcessed(state.iterations() * prefetch_elements);
+}
+BENCHMARK_TEMPLATE(BM_Prefetch_SearchPlain, SingleLinkedList<int>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Prefetch_SearchPlain, DoubleLinkedList<int>)->Unit(benchmark::kMillisecond);
+
+template <class List>
+static void BM_Prefetch_Search(benchmark::State& state) {
+	List list = make_scattered<List>(prefetch_elements);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.search(-1));
+	}
+	state.SetItemsProcessed(state.iterations() * prefetch_elements);
+}
+BENCHMARK_TEMPLATE(BM_Prefetch_Search, SingleLinkedList<int>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Prefetch_Search, DoubleLinkedList<int>)->Unit(benchmark::kMillisecond);
+
+// mix() from the parallel section stands in for real work per element
+template <class List>
+static void BM_Prefetch_WorkPlain(benchmark::State& state) {
+	List list = make_scattered<List>(prefetch_elements);
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		for (int item : list) sum += mix(static_cast<std::uint64_t>(item));
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * prefetch_elements);
+}
+BENCHMARK_TEMPLATE(BM_Prefetch_WorkPlain, SingleLinkedList<int>)->Unit(benchmark::kMillisecond);
+
+template <class List, std::size_t Distance>
+static void BM_Prefetch_Work(benchmark::State& state) {
+	List list = make_scattered<List>(prefetch_elements);
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		list.template for_each<Distance>([&sum](int item) { sum += mix(static_cast<std::uint64_t>(item)); });
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * prefetch_elements);
+}
+BENCHMARK_TEMPLATE(BM_Prefetch_Work, SingleLinkedList<int>, 1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Prefetch_Work, SingleLinkedList<int>, 4)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Prefetch_Work, SingleLinkedList<int>, 16)->Unit(benchmark::kMillisecond);
+
+template <class List>
+static void BM_Prefetch_Copy(benchmark::State& state) {
+	const List list = make_scattered<List>(prefetch_elements);
+	for (auto _ : state) {
+		List copy{ list };
+		benchmark::DoNotOptimize(copy);
+		state.PauseTiming();
+		copy.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * prefetch_elements);
+}
+BENCHMARK_TEMPLATE(BM_Prefetch_Copy, SingleLinkedList<int>)->Unit(benchmark::kMillisecond);
+
+template <class List>
+static void BM_Prefetch_PrintPlain(benchmark::State& state) {
+	List list = make_scattered<List>(prefetch_elements);
+	for (auto _ : state) {
+		std::ostringstream out;
+		for (int item : list) out << item << "\t";
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetItemsProcessed(state.iterations() * prefetch_elements);
+}
+BENCHMARK_TEMPLATE(BM_Prefetch_PrintPlain, SingleLinkedList<int>)->Unit(benchmark::kMillisecond);
+
+template <class List>
+static void BM_Prefetch_Print(benchmark::State& state) {
+	List list = make_scattered<List>(prefetch_elements);
+	for (auto _ : state) {
+		std::ostringstream out;
+		out << list;
+		benchmark::DoNotOptimize(out);
+	}
+	state.SetItemsProcessed(state.iterations() * prefetch_elements);
+}
+BENCHMARK_TEMPLATE(BM_Prefetch_Print, SingleLinkedList<int>)->Unit(benchmark::kMillisecond);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Multi-key search ////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// range(1) keys against a list of 0 .. range(0) - 1, every other key present.
+// The last key is absent, so neither approach can stop early
+static std::vector<int> make_search_keys(int n, int count) {
+	std::vector<int> keys;
+	for (int i = 0; i < count; ++i) keys.push_back(i % 2 == 0 ? static_cast<int>(std::int64_t(i) * n / count) : -1 - i);
+	keys.back() = -1;
+	return keys;
+}
+
+template <class List>
+static void BM_SearchMany_RepeatedSearch(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	const std::vector<int> keys = make_search_keys(n, static_cast<int>(state.range(1)));
+	for (auto _ : state) {
+		std::vector<bool> found;
+		for (int key : keys) found.push_back(list.search(key));
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_TEMPLATE(BM_SearchMany_RepeatedSearch, SingleLinkedList<int>)->Args({ 100000, 1000 })->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SearchMany_RepeatedSearch, DoubleLinkedList<int>)->Args({ 100000, 1000 })->Unit(benchmark::kMillisecond);
+
+template <class List>
+static void BM_SearchMany(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	const std::vector<int> keys = make_search_keys(n, static_cast<int>(state.range(1)));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.search_many(keys.begin(), keys.end()));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_TEMPLATE(BM_SearchMany, SingleLinkedList<int>)->Args({ 100000, 1000 })->Args({ 1000000, 1000 })->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SearchMany, DoubleLinkedList<int>)->Args({ 100000, 1000 })->Args({ 1000000, 1000 })->Unit(benchmark::kMillisecond);
+
+template <class List>
+static void BM_FindAll(benchmark::State& state) {
+	const auto n = static_cast<int>(state.range(0));
+	List list = make_filled<List>(n);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(list.find_all([](int x) { return x % 64 == 0; }));
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_FindAll, SingleLinkedList<int>)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_FindAll, DoubleLinkedList<int>)->Arg(1000000);
+
+
+///////////////////////////////////////////////////////////////////////
+///////////////////////////// Operations //////////////////////////////
+///////////////////////////////////////////////////////////////////////
+
+// Every public operation of the two lists next to the standard containers,
+// for int, a 64 byte POD and std::string elements. Operations a container
+// lacks are left out, and the ones that are quadratic on std::vector stop
+// at 1e4 elements there.
+
+struct Pod64 {
+	std::int64_t key;
+	char payload[56];
+};
+static_assert(sizeof(Pod64) == 64, "Pod64 should fill a cache line");
+
+static bool operator==(const Pod64& lhs, const Pod64& rhs) { return lhs.key == rhs.key; }
+
+template <class T>
+static T make_value(std::size_t i);
+
+template <>
+int make_value<int>(std::size_t i) { return static_cast<int>(i); }
+
+template <>
+Pod64 make_value<Pod64>(std::size_t i) { return { static_cast<std::int64_t>(i), {} }; }
+
+// Long enough to stay out of the small string buffer
+template <>
+std::string make_value<std::string>(std::size_t i) { return "benchmark element " + std::to_string(i); }
+
+template <class T>
+using BackLinkedList = SingleLinkedList<T, std::allocator<T>, true>;
+
+template <class Container>
+struct is_forward_list : std::false_type {};
+
+template <class T, class Allocator>
+struct is_forward_list<std::forward_list<T, Allocator>> : std::true_type {};
+
+template <class Container, class = void>
+struct has_search : std::false_type {};
+
+template <class Container>
+struct has_search<Container, std::void_t<decltype(std::declval<Container&>().search(std::declval<typename Container::value_type>()))>> : std::true_type {};
+
+template <class Container>
+static Container make_elements(std::size_t n) {
+	using T = typename Container::value_type;
+	Container container;
+	if constexpr (is_forward_list<Container>::value) {
+		for (std::size_t i = n; i > 0; --i) container.push_front(make_value<T>(i - 1));
+	}
+	else {
+		for (std::size_t i = 0; i < n; ++i) container.push_back(make_value<T>(i));
+	}
+	return container;
+}
+
+template <class Container>
+static bool contains(Container& container, const typename Container::value_type& x) {
+	if constexpr (has_search<Container>::value) return container.search(x);
+	else return std::find(container.begin(), container.end(), x) != container.end();
+}
+
+template <class Container>
+static std::size_t element_count(const Container& container) {
+	if constexpr (is_forward_list<Container>::value) return static_cast<std::size_t>(std::distance(container.begin(), container.end()));
+	else return container.size();
+}
+
+// Times op on a container holding prefill elements, building and destroying it are not timed
+template <class Container, class Operation>
+static void time_operation(benchmark::State& state, std::size_t prefill, Operation op) {
+	const auto n = static_cast<std::size_t>(state.range(0));
+	for (auto _ : state) {
+		Container container = make_elements<Container>(prefill);
+		const auto start = std::chrono::steady_clock::now();
+		op(container, n);
+		const auto stop = std::chrono::steady_clock::now();
+		benchmark::DoNotOptimize(container);
+		state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_Op_PushBack(benchmark::State& state) {
+	using T = typename Container::value_type;
+	const T value = make_value<T>(7);
+	time_operation<Container>(state, 0, [&value](Container& container, std::size_t n) {
+		for (std::size_t i = 0; i < n; ++i) container.push_back(value);
+	});
+}
+
+template <class Container>
+static void BM_Op_PushFront(benchmark::State& state) {
+	using T = typename Container::value_type;
+	const T value = make_value<T>(7);
+	time_operation<Container>(state, 0, [&value](Container& container, std::size_t n) {
+		for (std::size_t i = 0; i < n; ++i) container.push_front(value);
+	});
+}
+
+// Builds each element in place at the back, or the front for std::forward_list
+template <class Container>
+static void BM_Op_Emplace(benchmark::State& state) {
+	using T = typename Container::value_type;
+	time_operation<Container>(state, 0, [](Container& container, std::size_t n) {
+		for (std::size_t i = 0; i < n; ++i) {
+			if constexpr (is_forward_list<Container>::value) container.emplace_front(make_value<T>(i));
+			else container.emplace_back(make_value<T>(i));
+		}
+	});
+}
+
+// One new element after each existing one, doubling the length
+template <class Container>
+static void BM_Op_InsertAfter(benchmark::State& state) {
+	using T = typename Container::value_type;
+	const T value = make_value<T>(7);
+	time_operation<Container>(state, static_cast<std::size_t>(state.range(0)), [&value](Container& container, std::size_t n) {
+		if constexpr (std::is_same<Container, std::vector<T>>::value) {
+			for (std::size_t i = 0; i < n; ++i) container.insert(container.begin() + std::ptrdiff_t(2 * i + 1), value);
+		}
+		else if constexpr (is_forward_list<Container>::value || std::is_same<Container, SingleLinkedList<T>>::value) {
+			for (auto pos = container.begin(); pos != container.end(); ++pos) pos = container.insert_after(pos, value);
+		}
+		else {
+			for (auto pos = container.begin(); pos != container.end(); ++pos) pos = container.insert(std::next(pos), value);
+		}
+	});
+}
+
+// Erases every second element, halving the length
+template <class Container>
+static void BM_Op_EraseAfter(benchmark::State& state) {
+	using T = typename Container::value_type;
+	time_operation<Container>(state, static_cast<std::size_t>(state.range(0)), [](Container& container, std::size_t n) {
+		if constexpr (std::is_same<Container, std::vector<T>>::value) {
+			for (std::size_t i = 1; i <= n / 2; ++i) container.erase(container.begin() + std::ptrdiff_t(i));
+		}
+		else if constexpr (is_forward_list<Container>::value || std::is_same<Container, SingleLinkedList<T>>::value) {
+			for (auto pos = container.begin(); pos != container.end() && std::next(pos) != container.end(); ++pos) container.erase_after(pos);
+		}
+		else {
+			for (auto pos = container.begin(); pos != container.end() && std::next(pos) != container.end(); ) pos = container.erase(std::next(pos));
+		}
+	});
+}
+
+template <class Container>
+static void BM_Op_PopBack(benchmark::State& state) {
+	time_operation<Container>(state, static_cast<std::size_t>(state.range(0)), [](Container& container, std::size_t) {
+		while (!container.empty()) container.pop_back();
+	});
+}
+
+// Looks for a value that is not there
+template <class Container>
+static void BM_Op_Search(benchmark::State& state) {
+	using T = typename Container::value_type;
+	const auto n = static_cast<std::size_t>(state.range(0));
+	Container container = make_elements<Container>(n);
+	const T absent = make_value<T>(n + 1);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(contains(container, absent));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <class Container>
+static void BM_Op_Size(benchmark::State& state) {
+	Container container = make_elements<Container>(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(container);
+		benchmark::DoNotOptimize(element_count(container));
+	}
+}
+
+template <class Container>
+static void BM_Op_Copy(benchmark::State& state) {
+	const Container source = make_elements<Container>(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		Container copy{ source };
+		benchmark::DoNotOptimize(copy);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Move construction and move assignment, back and forth
+template <class Container>
+static void BM_Op_Move(benchmark::State& state) {
+	Container container = make_elements<Container>(static_cast<std::size_t>(state.range(0)));
+	for (auto _ : state) {
+		Container moved{ std::move(container) };
+		container = std::move(moved);
+		benchmark::DoNotOptimize(container);
+	}
+}
+
+template <class Container>
+static void BM_Op_Clear(benchmark::State& state) {
+	time_operation<Container>(state, static_cast<std::size_t>(state.range(0)), [](Container& container, std::size_t) {
+		container.clear();
+	});
+}
+
+// One registration per element type, timed is either real or manual
+#define BENCHMARK_OPERATION(func, Container, max, timed)										\
+	BENCHMARK_TEMPLATE(func, Container<int>)->RangeMultiplier(10)->Range(100, max)->timed();			\
+	BENCHMARK_TEMPLATE(func, Container<Pod64>)->RangeMultiplier(10)->Range(100, max)->timed();		\
+	BENCHMARK_TEMPLATE(func, Container<std::string>)->RangeMultiplier(10)->Range(100, max)->timed()
+
+BENCHMARK_OPERATION(BM_Op_PushBack, SingleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PushBack, DoubleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PushBack, std::list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PushBack, std::vector, 10000000, UseManualTime);
+
+BENCHMARK_OPERATION(BM_Op_PushFront, SingleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PushFront, DoubleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PushFront, std::list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PushFront, std::forward_list, 10000000, UseManualTime);
+
+BENCHMARK_OPERATION(BM_Op_Emplace, SingleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Emplace, DoubleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Emplace, std::list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Emplace, std::forward_list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Emplace, std::vector, 10000000, UseManualTime);
+
+BENCHMARK_OPERATION(BM_Op_InsertAfter, SingleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_InsertAfter, DoubleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_InsertAfter, std::list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_InsertAfter, std::forward_list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_InsertAfter, std::vector, 10000, UseManualTime);
+
+BENCHMARK_OPERATION(BM_Op_EraseAfter, SingleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_EraseAfter, DoubleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_EraseAfter, std::list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_EraseAfter, std::forward_list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_EraseAfter, std::vector, 10000, UseManualTime);
+
+// SingleLinkedList needs its back links here, without them every pop walks from the head
+BENCHMARK_OPERATION(BM_Op_PopBack, BackLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PopBack, DoubleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PopBack, std::list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_PopBack, std::vector, 10000000, UseManualTime);
+
+BENCHMARK_OPERATION(BM_Op_Search, SingleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Search, DoubleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Search, std::list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Search, std::forward_list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Search, std::vector, 10000000, UseRealTime);
+
+BENCHMARK_OPERATION(BM_Op_Size, SingleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Size, DoubleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Size, std::list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Size, std::forward_list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Size, std::vector, 10000000, UseRealTime);
+
+BENCHMARK_OPERATION(BM_Op_Copy, SingleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Copy, DoubleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Copy, std::list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Copy, std::forward_list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Copy, std::vector, 10000000, UseRealTime);
+
+BENCHMARK_OPERATION(BM_Op_Move, SingleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Move, DoubleLinkedList, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Move, std::list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Move, std::forward_list, 10000000, UseRealTime);
+BENCHMARK_OPERATION(BM_Op_Move, std::vector, 10000000, UseRealTime);
+
+BENCHMARK_OPERATION(BM_Op_Clear, SingleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Clear, DoubleLinkedList, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Clear, std::list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Clear, std::forward_list, 10000000, UseManualTime);
+BENCHMARK_OPERATION(BM_Op_Clear, std::vector, 10000000, UseManualTime);
+
+
+// Results also go to benchmark_results.json unless --benchmark_out says otherwise
+int main(int argc, char** argv) {
+	std::vector<char*> args(argv, argv + argc);
+	bool has_out = false;
+	for (int i = 1; i < argc; ++i) {
+		if (std::string(argv[i]).rfind("--benchmark_out=", 0) == 0) has_out = true;
+	}
+	char out[] = "--benchmark_out=benchmark_results.json";
+	char format[] = "--benchmark_out_format=json";
+	if (!has_out) {
+		args.push_back(out);
+		args.push_back(format);
+	}
+	args.push_back(nullptr);
+
+	int count = static_cast<int>(args.size()) - 1;
+	benchmark::Initialize(&count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+}
@@ -0,0 +1,548 @@
+//
+//  CompactDoubleLinkedList.h
+//  Data Structure - LinkedList
+//
+// A doubly linked list for many small elements. Nodes live in blocks owned
+// by the list and link to each other by 32 bit index instead of by pointer,
+// so a node of ints is 12 bytes where a DoubleLinkedList node is 24 plus
+// the allocator's header. Index 0 is the null link, and erased nodes go on a
+// free list inside the blocks for the next insertion.
+//
+// Iterators are invalidated only when their own element is erased, as with
+// DoubleLinkedList; end() stays valid throughout.
+//
+// With XorLinks set a node stores previous ^ next in a single index, after
+// Sinha's XOR linked list, and a node of ints shrinks to 8 bytes. A node's
+// neighbours can then only be worked out from one of them, so iterators
+// carry the index of the node before them as well. An XOR iterator is
+// invalidated when that previous node is erased or something is inserted
+// right before it, not only when its own node goes. That includes end(),
+// which push_back() invalidates.
+//
+// A list holds at most 2^32 - 2 elements. Blocks never move, so references
+// to elements stay valid until their element is erased.
+//
+
+#ifndef COMPACTDOUBLELINKEDLIST_h
+#define COMPACTDOUBLELINKEDLIST_h
+
+
+namespace detail {
+
+	template <bool XorLinks>
+	struct CompactLinks {
+		std::uint32_t next = 0;
+		std::uint32_t previous = 0;
+	};
+
+	template <>
+	struct CompactLinks<true> {
+		std::uint32_t both = 0;			// previous ^ next
+	};
+}
+
+template <class T, bool XorLinks = false, class Allocator = std::allocator<T>>
+class CompactDoubleLinkedList {
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using index_type = std::uint32_t;
+
+private:
+
+	struct Node {
+		union {
+			T data;						// only constructed while the node is in the list
+		};
+		detail::CompactLinks<XorLinks> links;
+
+		Node() noexcept {}
+		~Node() {}
+	};
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+	using block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node*>;
+
+	static constexpr unsigned block_shift = 10;
+	static constexpr index_type block_nodes = index_type(1) << block_shift;
+	static constexpr index_type max_index = ~index_type(0) - 1;
+
+	std::vector<Node*, block_allocator> blocks;
+	index_type head = 0;
+	index_type tail = 0;
+	index_type used = 1;				// slots handed out so far, slot 0 is the null link
+	index_type free_head = 0;			// erased slots, chained through their next link
+	std::size_t length = 0;
+	node_allocator alloc;
+
+	template <typename InputIt>
+	using RequireInputIterator = std::enable_if_t<std::is_convertible<
+		typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>::value>;
+
+	Node& node(index_type index) const noexcept { return blocks[index >> block_shift][index & (block_nodes - 1)]; }
+
+	// The neighbour of at that is not from
+	index_type step(index_type from, index_type at) const noexcept {
+		if constexpr (XorLinks) return node(at).links.both ^ from;
+		else return node(at).links.next != from ? node(at).links.next : node(at).links.previous;
+	}
+
+	// The node before current, given the one an iterator cached. Only XOR links need the
+	// cached index, otherwise it may be stale and the node's own link, or tail at end(), is used
+	index_type before(index_type previous, index_type current) const noexcept {
+		if constexpr (XorLinks) return previous;
+		else return current ? node(current).links.previous : tail;
+	}
+
+	// Move an iterator's pair of indices one node on or back
+	void advance(index_type &previous, index_type &current) const noexcept {
+		const index_type next = step(before(previous, current), current);
+		previous = current;
+		current = next;
+	}
+
+	void retreat(index_type &previous, index_type &current) const noexcept {
+		const index_type at = before(previous, current);
+		previous = step(current, at);
+		current = at;
+	}
+
+	index_type acquire_slot();
+	void release_slot(index_type index) noexcept;
+	void link_between(index_type before, index_type after, index_type index) noexcept;
+	void unlink_between(index_type before, index_type index, index_type after) noexcept;
+
+	template <typename... Args>
+	index_type emplace_between(index_type before, index_type after, Args&&... args);
+	void erase_between(index_type before, index_type index, index_type after) noexcept;
+
+public:
+	// Constructors
+	explicit CompactDoubleLinkedList(const Allocator &alloc = Allocator()) : blocks(block_allocator{ alloc }), alloc{ alloc } {}
+	CompactDoubleLinkedList(std::initializer_list<T> init, const Allocator &alloc = Allocator());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	CompactDoubleLinkedList(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+
+																			// Rule of 5
+	CompactDoubleLinkedList(CompactDoubleLinkedList const &source);			// Copy constructor, the copy has no free slots
+	CompactDoubleLinkedList(CompactDoubleLinkedList &&move) noexcept;		// Move constructor
+	CompactDoubleLinkedList& operator=(CompactDoubleLinkedList const &rhs);	// Copy assignment operator
+	CompactDoubleLinkedList& operator=(CompactDoubleLinkedList &&move) noexcept;	// Move assignment operator
+	~CompactDoubleLinkedList() noexcept;
+
+	// Create an iterator class
+	class iterator;
+	iterator begin() noexcept { return { this, 0, head }; }
+	iterator end() noexcept { return { this, tail, 0 }; }
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator cbegin() const noexcept { return { this, 0, head }; }
+	const_iterator cend() const noexcept { return { this, tail, 0 }; }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator end() const noexcept { return cend(); }
+
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	reverse_iterator rbegin() noexcept { return reverse_iterator{ end() }; }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{ end() }; }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator{ end() }; }
+	reverse_iterator rend() noexcept { return reverse_iterator{ begin() }; }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator{ begin() }; }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator{ begin() }; }
+
+	// Memeber functions
+	void swap(CompactDoubleLinkedList &other) noexcept;
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+	bool empty() const noexcept { return length == 0; }
+	size_type size() const noexcept { return length; }
+	size_type max_size() const noexcept { return max_index; }
+
+	// Bytes the list holds on the heap and in itself, slots on the free list included
+	size_type memory_usage() const noexcept {
+		return sizeof(*this) + blocks.capacity() * sizeof(Node*) + blocks.size() * block_nodes * sizeof(Node);
+	}
+
+	T& front() { return node(head).data; }
+	const T& front() const { return node(head).data; }
+	T& back() { return node(tail).data; }
+	const T& back() const { return node(tail).data; }
+
+	template<typename... Args>
+	void emplace_back(Args&&... args);
+
+	template<typename... Args>
+	void emplace_front(Args&&... args);
+
+	template<typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args);
+
+	void push_back(const T &theData);
+	void push_back(T &&theData);
+	void push_front(const T &theData);
+	void push_front(T &&theData);
+	iterator insert(const_iterator pos, const T& theData);
+	iterator insert(const_iterator pos, T&& theData);
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	void append_range(InputIt first, InputIt last);
+
+	void clear() noexcept;
+	void pop_front();
+	void pop_back();
+	iterator erase(const_iterator pos);
+	bool search(const T &x) const;
+};
+
+template <class T, bool XorLinks, class Allocator>
+class CompactDoubleLinkedList<T, XorLinks, Allocator>::iterator {
+	const CompactDoubleLinkedList* list = nullptr;
+	index_type previous = 0;
+	index_type current = 0;
+
+public:
+	friend class CompactDoubleLinkedList<T, XorLinks, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T * ;
+	using reference = T & ;
+
+	iterator() = default;
+	iterator(const CompactDoubleLinkedList* list, index_type previous, index_type current) : list{ list }, previous{ previous }, current{ current } {}
+
+	operator const_iterator() const noexcept { return const_iterator{ list, previous, current }; }
+	bool operator!=(iterator other) const noexcept { return current != other.current; }
+	bool operator==(iterator other) const noexcept { return current == other.current; }
+
+	T& operator*() const { return list->node(current).data; }
+	T* operator->() const { return &list->node(current).data; }
+
+	iterator& operator++() {
+		list->advance(previous, current);
+		return *this;
+	}
+	iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+
+	iterator& operator--() {
+		list->retreat(previous, current);
+		return *this;
+	}
+	iterator operator--(int) { auto copy = *this; --*this; return copy; }
+};
+
+template <class T, bool XorLinks, class Allocator>
+class CompactDoubleLinkedList<T, XorLinks, Allocator>::const_iterator {
+	const CompactDoubleLinkedList* list = nullptr;
+	index_type previous = 0;
+	index_type current = 0;
+
+public:
+	friend class CompactDoubleLinkedList<T, XorLinks, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T * ;
+	using reference = const T & ;
+
+	const_iterator() = default;
+	const_iterator(const CompactDoubleLinkedList* list, index_type previous, index_type current) : list{ list }, previous{ previous }, current{ current } {}
+
+	bool operator!=(const_iterator other) const noexcept { return current != other.current; }
+	bool operator==(const_iterator other) const noexcept { return current == other.current; }
+
+	const T& operator*() const { return list->node(current).data; }
+	const T* operator->() const { return &list->node(current).data; }
+
+	const_iterator& operator++() {
+		list->advance(previous, current);
+		return *this;
+	}
+	const_iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+
+	const_iterator& operator--() {
+		list->retreat(previous, current);
+		return *this;
+	}
+	const_iterator operator--(int) { auto copy = *this; --*this; return copy; }
+};
+
+
+template <class T, bool XorLinks, class Allocator>
+CompactDoubleLinkedList<T, XorLinks, Allocator>::CompactDoubleLinkedList(std::initializer_list<T> init, const Allocator &alloc) : blocks(block_allocator{ alloc }), alloc{ alloc } {
+	try {
+		append_range(init.begin(), init.end());
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+}
+
+template <class T, bool XorLinks, class Allocator>
+template <typename InputIt, typename>
+CompactDoubleLinkedList<T, XorLinks, Allocator>::CompactDoubleLinkedList(InputIt first, InputIt last, const Allocator &alloc) : blocks(block_allocator{ alloc }), alloc{ alloc } {
+	try {
+		append_range(first, last);
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+}
+
+template <class T, bool XorLinks, class Allocator>
+CompactDoubleLinkedList<T, XorLinks, Allocator>::CompactDoubleLinkedList(CompactDoubleLinkedList const &source)
+	: blocks(block_allocator{ node_traits::select_on_container_copy_construction(source.alloc) })
+	, alloc{ node_traits::select_on_container_copy_construction(source.alloc) } {
+	try {
+		append_range(source.begin(), source.end());
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+}
+
+template <class T, bool XorLinks, class Allocator>
+CompactDoubleLinkedList<T, XorLinks, Allocator>::CompactDoubleLinkedList(CompactDoubleLinkedList &&move) noexcept {
+	move.swap(*this);
+}
+
+template <class T, bool XorLinks, class Allocator>
+CompactDoubleLinkedList<T, XorLinks, Allocator>& CompactDoubleLinkedList<T, XorLinks, Allocator>::operator=(CompactDoubleLinkedList const &rhs) {
+	CompactDoubleLinkedList copy{ rhs };
+	swap(copy);
+	return *this;
+}
+
+template <class T, bool XorLinks, class Allocator>
+CompactDoubleLinkedList<T, XorLinks, Allocator>& CompactDoubleLinkedList<T, XorLinks, Allocator>::operator=(CompactDoubleLinkedList &&move) noexcept {
+	move.swap(*this);
+	return *this;
+}
+
+template <class T, bool XorLinks, class Allocator>
+CompactDoubleLinkedList<T, XorLinks, Allocator>::~CompactDoubleLinkedList() noexcept {
+	clear();
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::swap(CompactDoubleLinkedList &other) noexcept {
+	using std::swap;
+	swap(blocks, other.blocks);
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(used, other.used);
+	swap(free_head, other.free_head);
+	swap(length, other.length);
+	swap(alloc, other.alloc);
+}
+
+// A slot from the free list, otherwise the next one never used, adding a block when needed
+template <class T, bool XorLinks, class Allocator>
+typename CompactDoubleLinkedList<T, XorLinks, Allocator>::index_type CompactDoubleLinkedList<T, XorLinks, Allocator>::acquire_slot() {
+	if (free_head != 0) {
+		const index_type index = free_head;
+		if constexpr (XorLinks) free_head = node(index).links.both;
+		else free_head = node(index).links.next;
+		return index;
+	}
+
+	if (used > max_index) throw std::length_error("CompactDoubleLinkedList is out of 32 bit indices");
+	if ((used >> block_shift) == blocks.size()) {
+		// Room for the pointer first, so push_back can't throw with the block in hand
+		if (blocks.size() == blocks.capacity()) blocks.reserve(2 * blocks.capacity() + 1);
+		Node* block = node_traits::allocate(alloc, block_nodes);
+		for (index_type i = 0; i < block_nodes; ++i) node_traits::construct(alloc, block + i);
+		blocks.push_back(block);
+	}
+	return used++;
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::release_slot(index_type index) noexcept {
+	if constexpr (XorLinks) node(index).links.both = free_head;
+	else node(index).links.next = free_head;
+	free_head = index;
+}
+
+// Links index in between two neighbours, either of which may be the null link
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::link_between(index_type before, index_type after, index_type index) noexcept {
+	if constexpr (XorLinks) {
+		node(index).links.both = before ^ after;
+		if (before) node(before).links.both ^= after ^ index;
+		if (after) node(after).links.both ^= before ^ index;
+	}
+	else {
+		node(index).links.previous = before;
+		node(index).links.next = after;
+		if (before) node(before).links.next = index;
+		if (after) node(after).links.previous = index;
+	}
+	if (!before) head = index;
+	if (!after) tail = index;
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::unlink_between(index_type before, index_type index, index_type after) noexcept {
+	if constexpr (XorLinks) {
+		if (before) node(before).links.both ^= index ^ after;
+		if (after) node(after).links.both ^= index ^ before;
+	}
+	else {
+		if (before) node(before).links.next = after;
+		if (after) node(after).links.previous = before;
+	}
+	if (!before) head = after;
+	if (!after) tail = before;
+}
+
+template <class T, bool XorLinks, class Allocator>
+template <typename... Args>
+typename CompactDoubleLinkedList<T, XorLinks, Allocator>::index_type CompactDoubleLinkedList<T, XorLinks, Allocator>::emplace_between(index_type before, index_type after, Args&&... args) {
+	const index_type index = acquire_slot();
+	try {
+		node_traits::construct(alloc, std::addressof(node(index).data), std::forward<Args>(args)...);
+	}
+	catch (...) {
+		release_slot(index);
+		throw;
+	}
+	link_between(before, after, index);
+	++length;
+	return index;
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::erase_between(index_type before, index_type index, index_type after) noexcept {
+	unlink_between(before, index, after);
+	node_traits::destroy(alloc, std::addressof(node(index).data));
+	release_slot(index);
+	--length;
+}
+
+template <class T, bool XorLinks, class Allocator>
+template <typename... Args>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::emplace_back(Args&&... args) {
+	emplace_between(tail, 0, std::forward<Args>(args)...);
+}
+
+template <class T, bool XorLinks, class Allocator>
+template <typename... Args>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::emplace_front(Args&&... args) {
+	emplace_between(0, head, std::forward<Args>(args)...);
+}
+
+// Inserts before pos, the returned iterator is the new element
+template <class T, bool XorLinks, class Allocator>
+template <typename... Args>
+typename CompactDoubleLinkedList<T, XorLinks, Allocator>::iterator CompactDoubleLinkedList<T, XorLinks, Allocator>::emplace(const_iterator pos, Args&&... args) {
+	const index_type previous = before(pos.previous, pos.current);
+	const index_type index = emplace_between(previous, pos.current, std::forward<Args>(args)...);
+	return { this, previous, index };
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::push_back(const T &theData) {
+	emplace_back(theData);
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::push_back(T &&theData) {
+	emplace_back(std::move(theData));
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::push_front(const T &theData) {
+	emplace_front(theData);
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::push_front(T &&theData) {
+	emplace_front(std::move(theData));
+}
+
+template <class T, bool XorLinks, class Allocator>
+typename CompactDoubleLinkedList<T, XorLinks, Allocator>::iterator CompactDoubleLinkedList<T, XorLinks, Allocator>::insert(const_iterator pos, const T& theData) {
+	return emplace(pos, theData);
+}
+
+template <class T, bool XorLinks, class Allocator>
+typename CompactDoubleLinkedList<T, XorLinks, Allocator>::iterator CompactDoubleLinkedList<T, XorLinks, Allocator>::insert(const_iterator pos, T&& theData) {
+	return emplace(pos, std::move(theData));
+}
+
+template <class T, bool XorLinks, class Allocator>
+template <typename InputIt, typename>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::append_range(InputIt first, InputIt last) {
+	for (; first != last; ++first) emplace_back(*first);
+}
+
+// Destroys the elements and gives every block back
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::clear() noexcept {
+	if (!std::is_trivially_destructible<T>::value) {
+		for (index_type previous = 0, current = head; current != 0; ) {
+			const index_type next = step(previous, current);
+			node_traits::destroy(alloc, std::addressof(node(current).data));
+			previous = current;
+			current = next;
+		}
+	}
+	for (Node* block : blocks) {
+		for (index_type i = 0; i < block_nodes; ++i) node_traits::destroy(alloc, block + i);
+		node_traits::deallocate(alloc, block, block_nodes);
+	}
+	blocks.clear();
+	head = 0;
+	tail = 0;
+	used = 1;
+	free_head = 0;
+	length = 0;
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("List is Empty!!! Deletion is not possible.");
+	}
+	erase_between(0, head, step(0, head));
+}
+
+template <class T, bool XorLinks, class Allocator>
+void CompactDoubleLinkedList<T, XorLinks, Allocator>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("List is Empty!!! Deletion is not possible.");
+	}
+	erase_between(step(0, tail), tail, 0);
+}
+
+// The returned iterator is the element after the erased one
+template <class T, bool XorLinks, class Allocator>
+typename CompactDoubleLinkedList<T, XorLinks, Allocator>::iterator CompactDoubleLinkedList<T, XorLinks, Allocator>::erase(const_iterator pos) {
+	const index_type previous = before(pos.previous, pos.current);
+	const index_type after = step(previous, pos.current);
+	erase_between(previous, pos.current, after);
+	return { this, previous, after };
+}
+
+template <class T, bool XorLinks, class Allocator>
+bool CompactDoubleLinkedList<T, XorLinks, Allocator>::search(const T &x) const {
+	return std::find(begin(), end(), x) != end();
+}
+
+template <class T, bool XorLinks, class Allocator>
+std::ostream& operator<<(std::ostream &str, const CompactDoubleLinkedList<T, XorLinks, Allocator>& list) {
+	for (auto const& item : list) {
+		str << item << "\t";
+	}
+	return str;
+}
+
+#endif
@@ -0,0 +1,207 @@
+//
+//  ConcurrentSingleLinkedList.h
+//  Data Structure - LinkedList
+//
+// A lock-free singly linked list after Harris and Michael. Any number of
+// threads may push, erase and search at the same time without a mutex.
+//
+// Elements go in at the front only. Erasing first marks the victim's next link
+// (the logical delete), which stops anyone from linking behind it, and then
+// unlinks it from its predecessor. If that unlink loses a race, the node stays
+// until a later erase() walks past it: erase is the only operation that helps
+// unlink marked nodes, push_front never traverses. search() and for_each() skip
+// marked nodes without writing and never restart, and since nothing is ever
+// linked in behind the head they read, they finish in a bounded number of steps.
+//
+// Unlinked nodes are retired through EpochReclamation.h, so a node is only
+// freed once no thread can still be looking at it.
+//
+
+#ifndef CONCURRENTSINGLELINKEDLIST_h
+#define CONCURRENTSINGLELINKEDLIST_h
+
+#include "EpochReclamation.h"
+
+
+template <class T>
+class ConcurrentSingleLinkedList {
+private:
+
+	// The low bit of a link marks the node that owns the link as deleted
+	using link = std::uintptr_t;
+	static constexpr link marked_bit = 1;
+
+	struct Node {
+		T data;
+		std::atomic<link> next{ 0 };
+
+		template<typename... Args>
+		explicit Node(Args&&... args) : data{ std::forward<Args>(args)... } {}
+	};
+	static_assert(alignof(Node) > 1, "the mark bit lives in the low bit of a node address");
+
+	std::atomic<link> head{ 0 };
+	std::atomic<std::size_t> length{ 0 };
+
+	static Node* node_of(link l) noexcept { return reinterpret_cast<Node*>(l & ~marked_bit); }
+	static bool is_marked(link l) noexcept { return (l & marked_bit) != 0; }
+
+	struct Position {
+		std::atomic<link>* previous;
+		Node* node;
+	};
+
+	template <class Predicate>
+	Position find(Predicate pred, EpochGuard& guard);
+
+public:
+	using size_type = std::size_t;
+
+	// Constructors
+	ConcurrentSingleLinkedList() = default;
+	ConcurrentSingleLinkedList(ConcurrentSingleLinkedList const &) = delete;
+	ConcurrentSingleLinkedList& operator=(ConcurrentSingleLinkedList const &) = delete;
+	~ConcurrentSingleLinkedList() noexcept;
+
+	// Memeber functions, all safe to call concurrently
+	template<typename... Args>
+	void emplace_front(Args&&... args);
+
+	void push_front(const T &theData);
+	void push_front(T &&theData);
+	bool erase(const T &x);
+	bool search(const T &x) const;
+
+	template<typename Function>
+	void for_each(Function f) const;
+
+	bool empty() const noexcept { return node_of(head.load(std::memory_order_acquire)) == nullptr; }
+	size_type size() const noexcept { return length.load(std::memory_order_relaxed); }
+
+	// Not safe while other threads use the list
+	void clear() noexcept;
+};
+
+template <class T>
+ConcurrentSingleLinkedList<T>::~ConcurrentSingleLinkedList() noexcept {
+	clear();
+}
+
+template <class T>
+void ConcurrentSingleLinkedList<T>::clear() noexcept {
+	// Marked nodes that are still linked get freed here as well
+	Node* current = node_of(head.exchange(0, std::memory_order_acquire));
+	while (current) {
+		Node* next = node_of(current->next.load(std::memory_order_relaxed));
+		delete current;
+		current = next;
+	}
+	length.store(0, std::memory_order_relaxed);
+}
+
+// Finds the first live node matching pred and the link that points at it,
+// unlinking every marked node on the way
+template <class T>
+template <class Predicate>
+typename ConcurrentSingleLinkedList<T>::Position ConcurrentSingleLinkedList<T>::find(Predicate pred, EpochGuard& guard) {
+retry:
+	std::atomic<link>* previous = &head;
+	link current = previous->load(std::memory_order_acquire);
+
+	while (Node* node = node_of(current)) {
+		link next = node->next.load(std::memory_order_acquire);
+
+		if (is_marked(next)) {
+			// Fails if previous changed or its own node got marked, start over then
+			link expected = current;
+			if (!previous->compare_exchange_strong(expected, next & ~marked_bit, std::memory_order_acq_rel, std::memory_order_acquire)) {
+				goto retry;
+			}
+			guard.retire(node);
+			current = next & ~marked_bit;
+			continue;
+		}
+
+		if (pred(node->data)) return { previous, node };
+
+		previous = &node->next;
+		current = next;
+	}
+	return { previous, nullptr };
+}
+
+template <class T>
+template <typename... Args>
+void ConcurrentSingleLinkedList<T>::emplace_front(Args&&... args) {
+	Node* node = new Node(std::forward<Args>(args)...);
+
+	link first = head.load(std::memory_order_relaxed);
+	do {
+		node->next.store(first, std::memory_order_relaxed);
+	} while (!head.compare_exchange_weak(first, reinterpret_cast<link>(node), std::memory_order_release, std::memory_order_relaxed));
+
+	length.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <class T>
+void ConcurrentSingleLinkedList<T>::push_front(const T &theData) {
+	emplace_front(theData);
+}
+
+template <class T>
+void ConcurrentSingleLinkedList<T>::push_front(T &&theData) {
+	emplace_front(std::move(theData));
+}
+
+template <class T>
+bool ConcurrentSingleLinkedList<T>::erase(const T &x) {
+	EpochGuard guard;
+
+	for (;;) {
+		Position pos = find([&x](const T& data) { return data == x; }, guard);
+		if (!pos.node) return false;
+
+		link next = pos.node->next.load(std::memory_order_acquire);
+		if (is_marked(next)) continue;		// somebody else got there first
+
+		// Logical delete: once the link is marked nothing can be linked behind the node
+		if (!pos.node->next.compare_exchange_strong(next, next | marked_bit, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			continue;
+		}
+		length.fetch_sub(1, std::memory_order_relaxed);
+
+		// Physical delete, or leave it to the next erase that passes by
+		link expected = reinterpret_cast<link>(pos.node);
+		if (pos.previous->compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+			guard.retire(pos.node);
+		}
+		return true;
+	}
+}
+
+template <class T>
+bool ConcurrentSingleLinkedList<T>::search(const T &x) const {
+	EpochGuard guard;
+
+	for (Node* node = node_of(head.load(std::memory_order_acquire)); node != nullptr; ) {
+		link next = node->next.load(std::memory_order_acquire);
+		if (!is_marked(next) && node->data == x) return true;
+		node = node_of(next);
+	}
+	return false;
+}
+
+// Visits every element that is not deleted, the list may change meanwhile
+template <class T>
+template <typename Function>
+void ConcurrentSingleLinkedList<T>::for_each(Function f) const {
+	EpochGuard guard;
+
+	for (Node* node = node_of(head.load(std::memory_order_acquire)); node != nullptr; ) {
+		link next = node->next.load(std::memory_order_acquire);
+		if (!is_marked(next)) f(static_cast<const T&>(node->data));
+		node = node_of(next);
+	}
+}
+
+#endif
@@ -1,552 +1,1162 @@
-//
-//  SingleLinkedList.h
-//  Data Structure - LinkedList
-//
-//  Created by Morgan Weiss on 8/7/2018
-//  Copyright  2018 Morgan Weiss. All rights reserved.
-// 
-// Note: You know pointer != nullptr is the same as pointer in a boolean context? 
-// The same for pointer == nullptr and !pointer.
-//
-
-#ifndef DOUBLELINKEDLIST_h
-#define DOUBLELINKEDLIST_h
-
-
-template <class T>
-class DoubleLinkedList {
-private:
-
-	struct Node {
-		T data;
-		std::unique_ptr<Node> next = nullptr;
-		Node* previous = nullptr;
-
-
-		template<typename... Args, typename = std::enable_if_t<std::is_constructible<T, Args&&...>::value>>
-		explicit Node(std::unique_ptr<Node>&& next, Node* previous, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value)
-			: data{ std::forward<Args>(args)... }, previous{previous}, next{ std::move(next) } {}
-
-		// disable if noncopyable<T> for cleaner error msgs
-		explicit Node(const T& x, std::unique_ptr<Node>&& p = nullptr)
-			: data(x)
-			, next(std::move(p)) {}
-
-		// disable if nonmovable<T> for cleaner error msgs
-		explicit Node(T&& x, std::unique_ptr<Node>&& p = nullptr)
-			: data(std::move(x))
-			, next(std::move(p)) {}
-	};
-	std::unique_ptr<Node> head = nullptr;
-	Node* tail = nullptr;
-
-	void do_pop_front() {
-		head = std::move(head->next);
-		if (!tail) tail = head.get(); // update tail if list was empty before
-	}
-
-public:
-	// Constructors
-	DoubleLinkedList() = default;											// empty constructor 
-	DoubleLinkedList(DoubleLinkedList const &source);						// copy constructor
-
-																			// Rule of 5
-	DoubleLinkedList(DoubleLinkedList &&move) noexcept;						// move constructor
-	DoubleLinkedList& operator=(DoubleLinkedList &&move) noexcept;			// move assignment operator
-	~DoubleLinkedList() noexcept;
-
-	// Overload operators
-	DoubleLinkedList& operator=(DoubleLinkedList const &rhs);
-
-	// Create an iterator class
-	class iterator;
-	iterator begin();
-	iterator end();
-	iterator before_begin();
-
-	// Create const iterator class
-	class const_iterator;
-	const_iterator cbegin() const;
-	const_iterator cend() const;
-	const_iterator begin() const;
-	const_iterator end() const;
-	const_iterator before_begin() const;
-	const_iterator cbefore_begin() const;
-
-	// Reverse iteator 
-	using reverse_iterator = std::reverse_iterator<iterator>;
-	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-	reverse_iterator rbegin() noexcept { return { end() }; }
-	const_reverse_iterator rbegin() const noexcept { return { end() }; }
-	const_reverse_iterator crbegin() const noexcept { return { end() }; }
-
-	reverse_iterator rend() noexcept { return { begin() }; }
-	const_reverse_iterator rend() const noexcept { return { begin() }; }
-	const_reverse_iterator crend() const noexcept { return { begin() }; }
-
-	// Memeber functions
-	void swap(DoubleLinkedList &other) noexcept;
-	bool empty() const { return head.get() == nullptr; }
-	int size() const;
-
-	template<typename... Args>
-	void emplace_back(Args&&... args);
-
-	template<typename... Args>
-	void emplace_front(Args&&... args);
-
-	template<typename... Args>
-	iterator emplace(const_iterator pos, Args&&... args);
-
-	void push_back(const T &theData);
-	void push_back(T &&theData);
-	void push_front(const T &theData);
-	void push_front(T &&theData);
-	iterator insert(const_iterator pos, const T& theData);
-	iterator insert(const_iterator pos, T&& theData);
-	void clear();
-	void pop_front();
-	void pop_back();
-	iterator erase(const_iterator pos);
-	bool search(const T &x);
-
-
-};
-
-template <class T>
-class DoubleLinkedList<T>::iterator {
-	Node* node = nullptr;
-	bool end_reached = true;
-
-public:
-	friend class DoubleLinkedList<T>;
-
-	using iterator_category = std::bidirectional_iterator_tag;
-	using value_type = T;
-	using difference_type = std::ptrdiff_t;
-	using pointer = T * ;
-	using reference = T & ;
-
-	iterator(Node* node = nullptr, bool end_reached = false) : node{ node }, end_reached{ end_reached }  {}
-
-	operator const_iterator() const noexcept { return const_iterator{ node }; }
-	bool operator!=(iterator other) const noexcept;
-	bool operator==(iterator other) const noexcept;
-
-	T& operator*() const { return node->data; }
-	T* operator->() const { return &node->data; }
-
-	iterator& operator++();
-	iterator operator++(int);
-	iterator& operator--();
-	iterator operator--(int);
-};
-
-template <class T>
-class DoubleLinkedList<T>::const_iterator {
-	Node* node = nullptr;
-	bool end_reached = true;
-
-public:
-	friend class DoubleLinkedList<T>;
-
-	using iterator_category = std::bidirectional_iterator_tag;
-	using value_type = T;
-	using difference_type = std::ptrdiff_t;
-	using pointer = const T *;
-	using reference = const T &;
-
-	const_iterator() = default;
-	const_iterator(Node* node, bool end_reached = false) : node{ node }, end_reached { end_reached }  {}
-
-
-	bool operator!=(const_iterator other) const noexcept;
-	bool operator==(const_iterator other) const noexcept;
-
-	const T& operator*() const { return node->data; }
-	const T* operator->() const { return &node->data; }
-
-	const_iterator& operator++();
-	const_iterator operator++(int);
-	const_iterator& operator--();
-	const_iterator operator--(int);
-};
-
-template <class T>
-DoubleLinkedList<T>::DoubleLinkedList(DoubleLinkedList<T> const &source) {
-	for (Node* loop = source.head.get(); loop != nullptr; loop = loop->next.get()) {
-		push_back(loop->data);
-	}
-}
-
-template <class T>
-DoubleLinkedList<T>::DoubleLinkedList(DoubleLinkedList<T>&& move) noexcept {
-	move.swap(*this);
-}
-
-template <class T>
-DoubleLinkedList<T>& DoubleLinkedList<T>::operator=(DoubleLinkedList<T> &&move) noexcept {
-	move.swap(*this);
-	return *this;
-}
-
-template <class T>
-DoubleLinkedList<T>::~DoubleLinkedList() {
-	clear();
-}
-
-template <class T>
-void DoubleLinkedList<T>::clear() {
-	while (head) {
-		do_pop_front();
-	}
-}
-
-template <class T>
-DoubleLinkedList<T>& DoubleLinkedList<T>::operator=(DoubleLinkedList const &rhs) {
-	SingleLinkedList copy{ rhs };
-	swap(copy);
-	return *this;
-}
-
-template <class T>
-void DoubleLinkedList<T>::swap(DoubleLinkedList &other) noexcept {
-	using std::swap;
-	swap(head, other.head);
-	swap(tail, other.tail);
-}
-
-template <class T>
-int DoubleLinkedList<T>::size() const {
-	int size = 0;
-	for (auto current = head.get(); current != nullptr; current = current->next.get()) {
-		size++;
-	}
-	return size;
-}
-
-template <class T>
-template <typename... Args>
-void DoubleLinkedList<T>::emplace_back(Args&&... args) {
-	if (!head) emplace_front(std::forward<Args>(args)...);
-	else {
-		tail->next = std::make_unique<Node>(nullptr, tail, std::forward<Args>(args)...);
-		tail = tail->next.get();
-	}
-}
-
-template <class T>
-template <typename... Args>
-void DoubleLinkedList<T>::emplace_front(Args&&... args) {
-	head = std::make_unique<Node>(std::move(head), nullptr, std::forward<Args>(args)...);
-	if (!tail) tail = head.get(); // update tail if list was empty before
-}
-
-
-template <class T>
-template <typename... Args>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::emplace(const_iterator pos, Args&&... args) {
-	if (pos.end_reached) {
-		emplace_back(std::forward<Args>(args)...);
-		return end();
-	}
-
-	if (!head) {
-		emplace_front(std::forward<Args>(args)...);
-		return begin();
-	}
-	std::unique_ptr<Node> newNode = std::make_unique<Node>(std::forward<Args>(args)...);
-	newNode->previous = pos.node->previous;
-	newNode->next = std::move(pos.node->previous->next);
-	pos.node->previous = newNode.get();
-	newNode->previous->next = std::move(newNode);
-
-	return  {pos.node->previous}; 
-}
-
-template <class T>
-void DoubleLinkedList<T>::push_back(const T &theData) {
-	std::unique_ptr<Node> newNode = std::make_unique<Node>(std::move(theData));
-	newNode->previous = tail;
-
-	if (!head) {
-		head = std::move(newNode);
-		tail = head.get();
-	}
-	else {
-		tail->next = std::move(newNode);
-		tail = tail->next.get();
-	}
-}
-
-template <class T>
-void DoubleLinkedList<T>::push_back(T &&thedata) {
-	std::unique_ptr<Node> newNode = std::make_unique<Node>(std::move(thedata));
-	newNode->previous = tail;
-
-	if (!head) {
-		head = std::move(newNode);
-		tail = head.get();
-	}
-
-	else {
-		tail->next = std::move(newNode);
-		tail = tail->next.get();
-	}
-}
-
-
-template <class T>
-void DoubleLinkedList<T>::push_front(const T &theData) {
-	head = std::make_unique<Node>(std::move(head), nullptr, theData);
-
-	if (!(head->next)) {
-		tail = head.get();
-	}
-}
-
-template <class T>
-void DoubleLinkedList<T>::push_front(T &&theData) {
-	head = std::make_unique<Node>(std::move(head),nullptr,std::move(theData));
-
-	if (!(head->next)) {
-		tail = head.get();
-	}
-}
-
-
-template <class T>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::insert(const_iterator pos, const T& theData) {
-	return emplace(pos, theData);
-}
-
-template <class T>
-typename  DoubleLinkedList<T>::iterator DoubleLinkedList<T>::insert(const_iterator pos, T&& theData) {
-	return emplace(pos, std::move(theData));
-}
-
-template <class T>
-void DoubleLinkedList<T>::pop_front() {
-	if (empty()) {
-		throw std::out_of_range("List is Empty!!! Deletion is not possible.");
-	}
-
-	do_pop_front();
-}
-
-template <class T>
-void DoubleLinkedList<T>::pop_back() {
-	if (!head) {
-		return;
-	}
-
-	if (head) {
-		auto current = head.get();
-		Node* prev = nullptr;
-		while (current->next) {
-			prev = current;
-			current = current->next.get();
-		}
-		tail = prev;
-		prev->next = nullptr;
-	}
-	else {
-		throw std::out_of_range("The list is empty, nothing to delete.");
-	}
-}
-
-template <class T>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::erase(const_iterator pos) {
-	if (pos.end_reached) {
-		pop_back();
-		return end();
-	}
-
-	if (pos.node && pos.node->next) {
-		pos.node->next = std::move(pos.node->previous->next);
-		return { pos.node->previous };
-	}
-
-	return begin();
-}
-
-template <class T>
-bool DoubleLinkedList<T>::search(const T &x) {
-	return std::find(begin(), end(), x) != end();
-}
-
-template <typename T>
-std::ostream& operator<<(std::ostream &str, DoubleLinkedList<T>& list) {
-	for (auto const& item : list) {
-		str << item << "\t";
-	}
-	return str;
-}
-
-
-// Iterator Implementaion////////////////////////////////////////////////
-template <class T>
-typename DoubleLinkedList<T>::iterator& DoubleLinkedList<T>::iterator::operator++() {
-	if (!node) return *this;
-
-	if (node->next) {
-		node = node->next.get();
-	}
-	
-	else {
-		end_reached = true;			// keep last node, so we can go backwards if required
-	}
-
-	return *this;
-}
-
-template<typename T>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::iterator::operator++(int) {
-	auto copy = *this;
-	++*this;
-	return copy;
-}
-
-template <class T>
-typename DoubleLinkedList<T>::iterator& DoubleLinkedList<T>::iterator::operator--() {
-	if (!node) return *this;
-
-	if (end_reached) {
-		end_reached = false;
-	}
-
-	else if (node->previous) {
-		node = node->previous.get();
-	}
-
-	return *this;
-}
-
-template<typename T>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::iterator::operator--(int) {
-	auto copy = *this;
-	--*this;
-	return copy;
-}
-
-template<typename T>
-bool DoubleLinkedList<T>::iterator::operator==(iterator other) const noexcept {
-	if (end_reached) return other.end_reached;
-	
-	if (other.end_reached) return false;
-
-	return node == other.node;
-}
-
-template<typename T>
-bool DoubleLinkedList<T>::iterator::operator!=(iterator other) const noexcept {
-	return !(*this == other);
-}
-
-template<class T>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::begin() {
-	return head.get();
-}
-
-template<class T>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::end() {
-	return {tail, true};
-}
-
-template <class T>
-typename DoubleLinkedList<T>::iterator DoubleLinkedList<T>::before_begin() {
-	return { head.get(), false };
-}
-
-// Const Iterator Implementaion////////////////////////////////////////////////
-template <class T>
-typename DoubleLinkedList<T>::const_iterator& DoubleLinkedList<T>::const_iterator::operator++() {
-	if (!node) return *this;
-
-	if (node->next) {
-		node = node->next.get();
-	}
-
-	else {
-		end_reached = true;			// keep last node, so we can go backwards if required
-	}
-
-	return *this;
-}
-
-template<typename T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::const_iterator::operator++(int) {
-	auto copy = *this;
-	++*this;
-	return copy;
-}
-
-template <class T>
-typename DoubleLinkedList<T>::const_iterator& DoubleLinkedList<T>::const_iterator::operator--() {
-	if (!node) return *this;
-
-	if (end_reached) {
-		end_reached = false;
-	}
-
-	else if (node->previous) {
-		node = node->previous.get();
-	}
-
-	return *this;
-}
-
-template<class T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::const_iterator::operator--(int) {
-	auto copy = *this;
-	--*this;
-	return copy;
-}
-
-template<class T>
-bool DoubleLinkedList<T>::const_iterator::operator==(const_iterator other) const noexcept {
-	if (end_reached) return other.end_reached;
-
-	if (other.end_reached) return false;
-
-	return node == other.node;
-}
-
-template<class T >
-bool DoubleLinkedList<T>::const_iterator::operator!=(const_iterator other) const noexcept {
-	return !(*this == other);
-}
-
-
-template <class T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::begin() const {
-	return head.get();
-}
-
-template <class T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::end() const {
-	return {tail, true};
-}
-
-template <class T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::cbegin() const {
-	return begin();
-}
-
-template <class T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::cend() const {
-	return end();
-}
-
-template <class T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::before_begin() const {
-	return { head.get(), true };
-}
-
-template <class T>
-typename DoubleLinkedList<T>::const_iterator DoubleLinkedList<T>::cbefore_begin() const {
-	return before_begin();
-}
-
-
+//
+//  SingleLinkedList.h
+//  Data Structure - LinkedList
+//
+//  Created by Morgan Weiss on 8/7/2018
+//  Copyright  2018 Morgan Weiss. All rights reserved.
+// 
+// Note: You know pointer != nullptr is the same as pointer in a boolean context? 
+// The same for pointer == nullptr and !pointer.
+//
+
+#ifndef DOUBLELINKEDLIST_h
+#define DOUBLELINKEDLIST_h
+
+#include "SimdSearch.h"
+#include "Prefetch.h"
+#include "KeySet.h"
+#include "PoolAllocator.h"
+#include "BackgroundReclaimer.h"
+
+
+template <class T, class Allocator = std::allocator<T>>
+class DoubleLinkedList {
+private:
+
+	struct Node;
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
+	// Each link hands its node back to the allocator it came from
+	struct NodeDeleter : node_allocator {
+		NodeDeleter() = default;
+		NodeDeleter(const node_allocator& alloc) : node_allocator(alloc) {}
+
+		void operator()(Node* node) noexcept {
+			node_traits::destroy(*this, node);
+			node_traits::deallocate(*this, node, 1);
+		}
+	};
+	using node_ptr = std::unique_ptr<Node, NodeDeleter>;
+
+	struct Node {
+		T data;
+		node_ptr next = nullptr;
+		Node* previous = nullptr;
+
+
+		template<typename... Args, typename = std::enable_if_t<std::is_constructible<T, Args&&...>::value>>
+		explicit Node(node_ptr&& next, Node* previous, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value)
+			: data{ std::forward<Args>(args)... }, next{ std::move(next) }, previous{ previous } {}
+
+		// disable if noncopyable<T> for cleaner error msgs
+		explicit Node(const T& x, node_ptr&& p = nullptr)
+			: data(x)
+			, next(std::move(p)) {}
+
+		// disable if nonmovable<T> for cleaner error msgs
+		explicit Node(T&& x, node_ptr&& p = nullptr)
+			: data(std::move(x))
+			, next(std::move(p)) {}
+	};
+	node_ptr head = nullptr;
+	Node* tail = nullptr;
+	std::size_t length = 0;
+	node_allocator alloc;
+
+	template <typename InputIt>
+	using RequireInputIterator = std::enable_if_t<std::is_convertible<
+		typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>::value>;
+
+	template <typename... Args>
+	node_ptr make_node(Args&&... args);
+
+	std::size_t count_nodes() const;
+
+	static Node* next_of(const Node* node) noexcept { return node->next.get(); }
+
+	template <typename Compare>
+	static void merge_chains(node_ptr &first, node_ptr &second, Compare &comp);
+	static void append_chain(node_ptr &chain, node_ptr &&rest) noexcept;
+	void restore_links() noexcept;
+
+	template <typename InputIt>
+	node_ptr build_chain(InputIt first, InputIt last, Node* &chain_tail, std::size_t &built);
+	static void free_chain(node_ptr chain) noexcept;
+	void truncate(Node* last_kept, std::size_t kept) noexcept;
+
+	void do_pop_front() {
+		head = std::move(head->next);
+		if (head) head->previous = nullptr;
+		else tail = nullptr;		// list became empty
+		--length;
+	}
+
+public:
+	// Constructors
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	DoubleLinkedList() = default;											// empty constructor 
+	explicit DoubleLinkedList(const Allocator &alloc);						// empty constructor with allocator
+	DoubleLinkedList(DoubleLinkedList const &source);						// copy constructor
+	DoubleLinkedList(size_type count, const T &value, const Allocator &alloc = Allocator());
+	DoubleLinkedList(std::initializer_list<T> init, const Allocator &alloc = Allocator());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	DoubleLinkedList(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+
+																			// Rule of 5
+	DoubleLinkedList(DoubleLinkedList &&move) noexcept;						// move constructor
+	DoubleLinkedList& operator=(DoubleLinkedList &&move) noexcept;			// move assignment operator
+	~DoubleLinkedList() noexcept;
+
+	// Overload operators
+	DoubleLinkedList& operator=(DoubleLinkedList const &rhs);
+	DoubleLinkedList& operator=(std::initializer_list<T> init);
+
+	// Create an iterator class
+	class iterator;
+	iterator begin();
+	iterator end();
+	iterator before_begin();
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator cbegin() const;
+	const_iterator cend() const;
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_iterator before_begin() const;
+	const_iterator cbefore_begin() const;
+
+	// Reverse iteator 
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	reverse_iterator rbegin() noexcept { return reverse_iterator{ end() }; }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{ end() }; }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator{ end() }; }
+
+	reverse_iterator rend() noexcept { return reverse_iterator{ begin() }; }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator{ begin() }; }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator{ begin() }; }
+
+	// Memeber functions
+	void swap(DoubleLinkedList &other) noexcept;
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+	bool empty() const { return head.get() == nullptr; }
+	size_type size() const noexcept;
+
+	template<typename... Args>
+	void emplace_back(Args&&... args);
+
+	template<typename... Args>
+	void emplace_front(Args&&... args);
+
+	template<typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args);
+
+	void push_back(const T &theData);
+	void push_back(T &&theData);
+	void push_front(const T &theData);
+	void push_front(T &&theData);
+	iterator insert(const_iterator pos, const T& theData);
+	iterator insert(const_iterator pos, T&& theData);
+	void clear();
+	void clear_async();
+	void pop_front();
+	void pop_back();
+	iterator erase(const_iterator pos);
+	bool search(const T &x);
+	size_type count(const T &x) const;
+
+	template<typename Predicate>
+	iterator find_if(Predicate pred);
+
+	template<std::size_t Distance = detail::prefetch_distance, typename Function>
+	void for_each(Function f);
+
+	template<std::size_t Distance = detail::prefetch_distance, typename Function>
+	void for_each(Function f) const;
+
+	template<typename InputIt>
+	bool contains_any(InputIt first, InputIt last) const;
+
+	template<typename InputIt>
+	std::vector<bool> search_many(InputIt first, InputIt last) const;
+
+	template<typename Predicate>
+	std::vector<iterator> find_all(Predicate pred);
+
+	template<typename Compare = std::less<T>>
+	void sort(Compare comp = Compare());
+
+	template<typename Compare = std::less<T>>
+	void merge(DoubleLinkedList &other, Compare comp = Compare());
+
+	template<typename Compare = std::less<T>>
+	void merge(DoubleLinkedList &&other, Compare comp = Compare());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	void assign(InputIt first, InputIt last);
+	void assign(size_type count, const T &value);
+	void assign(std::initializer_list<T> init);
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	iterator insert_range(const_iterator pos, InputIt first, InputIt last);
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	void append_range(InputIt first, InputIt last);
+
+	void splice(const_iterator pos, DoubleLinkedList &other) noexcept;
+	void splice(const_iterator pos, DoubleLinkedList &&other) noexcept;
+	void splice(const_iterator pos, DoubleLinkedList &other, const_iterator it) noexcept;
+	void splice(const_iterator pos, DoubleLinkedList &&other, const_iterator it) noexcept;
+	void splice(const_iterator pos, DoubleLinkedList &other, const_iterator first, const_iterator last) noexcept;
+	void splice(const_iterator pos, DoubleLinkedList &&other, const_iterator first, const_iterator last) noexcept;
+
+private:
+	node_ptr unlink(Node* first, Node* last) noexcept;
+	void link_before(Node* pos, node_ptr chain, Node* last) noexcept;
+	static Node* node_at(const_iterator pos) noexcept { return pos.end_reached ? nullptr : pos.node; }
+
+
+};
+
+template <class T, class Allocator>
+class DoubleLinkedList<T, Allocator>::iterator {
+	Node* node = nullptr;
+	bool end_reached = true;
+
+public:
+	friend class DoubleLinkedList<T, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T * ;
+	using reference = T & ;
+
+	iterator(Node* node = nullptr, bool end_reached = false) : node{ node }, end_reached{ end_reached }  {}
+
+	operator const_iterator() const noexcept { return const_iterator{ node, end_reached }; }
+	bool operator!=(iterator other) const noexcept;
+	bool operator==(iterator other) const noexcept;
+
+	T& operator*() const { return node->data; }
+	T* operator->() const { return &node->data; }
+
+	iterator& operator++();
+	iterator operator++(int);
+	iterator& operator--();
+	iterator operator--(int);
+};
+
+template <class T, class Allocator>
+class DoubleLinkedList<T, Allocator>::const_iterator {
+	Node* node = nullptr;
+	bool end_reached = true;
+
+public:
+	friend class DoubleLinkedList<T, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T *;
+	using reference = const T &;
+
+	const_iterator() = default;
+	const_iterator(Node* node, bool end_reached = false) : node{ node }, end_reached { end_reached }  {}
+
+
+	bool operator!=(const_iterator other) const noexcept;
+	bool operator==(const_iterator other) const noexcept;
+
+	const T& operator*() const { return node->data; }
+	const T* operator->() const { return &node->data; }
+
+	const_iterator& operator++();
+	const_iterator operator++(int);
+	const_iterator& operator--();
+	const_iterator operator--(int);
+};
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>::DoubleLinkedList(const Allocator &alloc) : alloc{ alloc } {}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>::DoubleLinkedList(DoubleLinkedList<T, Allocator> const &source)
+	: alloc{ node_traits::select_on_container_copy_construction(source.alloc) } {
+	append_range(source.begin(), source.end());
+}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>::DoubleLinkedList(size_type count, const T &value, const Allocator &alloc) : alloc{ alloc } {
+	assign(count, value);
+}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>::DoubleLinkedList(std::initializer_list<T> init, const Allocator &alloc) : alloc{ alloc } {
+	append_range(init.begin(), init.end());
+}
+
+template <class T, class Allocator>
+template <typename InputIt, typename>
+DoubleLinkedList<T, Allocator>::DoubleLinkedList(InputIt first, InputIt last, const Allocator &alloc) : alloc{ alloc } {
+	append_range(first, last);
+}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>::DoubleLinkedList(DoubleLinkedList<T, Allocator>&& move) noexcept {
+	move.swap(*this);
+}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>& DoubleLinkedList<T, Allocator>::operator=(DoubleLinkedList<T, Allocator> &&move) noexcept {
+	move.swap(*this);
+	return *this;
+}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>::~DoubleLinkedList() noexcept {
+	clear();
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::clear() {
+	free_chain(std::move(head));
+	tail = nullptr;
+	length = 0;
+}
+
+// Detaches the nodes at once and leaves freeing them to BackgroundReclaimer.
+// Falls back to clear() if the hand-off cannot be queued.
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::clear_async() {
+	if (!head) return;
+
+	node_ptr* chain = new (std::nothrow) node_ptr{ std::move(head) };
+	tail = nullptr;
+	length = 0;
+	if (!chain) {
+		free_chain(std::move(head));
+		return;
+	}
+
+	try {
+		BackgroundReclaimer::post(chain, [](void* p) {
+			node_ptr* detached = static_cast<node_ptr*>(p);
+			free_chain(std::move(*detached));
+			delete detached;
+		});
+	}
+	catch (...) {
+		free_chain(std::move(*chain));
+		delete chain;
+	}
+}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>& DoubleLinkedList<T, Allocator>::operator=(DoubleLinkedList const &rhs) {
+	DoubleLinkedList copy{ rhs };
+	swap(copy);
+	return *this;
+}
+
+template <class T, class Allocator>
+DoubleLinkedList<T, Allocator>& DoubleLinkedList<T, Allocator>::operator=(std::initializer_list<T> init) {
+	assign(init);
+	return *this;
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::swap(DoubleLinkedList &other) noexcept {
+	using std::swap;
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(length, other.length);
+	swap(alloc, other.alloc);
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::size_type DoubleLinkedList<T, Allocator>::size() const noexcept {
+	assert(length == count_nodes() && "cached size is out of sync with the chain");
+	return length;
+}
+
+template <class T, class Allocator>
+std::size_t DoubleLinkedList<T, Allocator>::count_nodes() const {
+	std::size_t nodes = 0;
+	detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&nodes](const Node*) { ++nodes; return false; });
+	return nodes;
+}
+
+template <class T, class Allocator>
+template <typename... Args>
+typename DoubleLinkedList<T, Allocator>::node_ptr DoubleLinkedList<T, Allocator>::make_node(Args&&... args) {
+	Node* node = node_traits::allocate(alloc, 1);
+	try {
+		node_traits::construct(alloc, node, std::forward<Args>(args)...);
+	}
+	catch (...) {
+		node_traits::deallocate(alloc, node, 1);
+		throw;
+	}
+	return { node, NodeDeleter{ alloc } };
+}
+
+template <class T, class Allocator>
+template <typename... Args>
+void DoubleLinkedList<T, Allocator>::emplace_back(Args&&... args) {
+	if (!head) emplace_front(std::forward<Args>(args)...);
+	else {
+		tail->next = make_node(nullptr, tail, std::forward<Args>(args)...);
+		tail = tail->next.get();
+		++length;
+	}
+}
+
+template <class T, class Allocator>
+template <typename... Args>
+void DoubleLinkedList<T, Allocator>::emplace_front(Args&&... args) {
+	head = make_node(std::move(head), nullptr, std::forward<Args>(args)...);
+	if (head->next) head->next->previous = head.get();
+	else tail = head.get(); // list was empty before
+	++length;
+}
+
+
+template <class T, class Allocator>
+template <typename... Args>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::emplace(const_iterator pos, Args&&... args) {
+	if (pos.end_reached) {
+		emplace_back(std::forward<Args>(args)...);
+		return { tail };
+	}
+
+	if (pos.node == head.get()) {
+		emplace_front(std::forward<Args>(args)...);
+		return begin();
+	}
+
+	// Link the new node between pos and its predecessor
+	Node* prev = pos.node->previous;
+	prev->next = make_node(std::move(prev->next), prev, std::forward<Args>(args)...);
+	pos.node->previous = prev->next.get();
+	++length;
+
+	return { prev->next.get() };
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::push_back(const T &theData) {
+	node_ptr newNode = make_node(std::move(theData));
+	newNode->previous = tail;
+
+	if (!head) {
+		head = std::move(newNode);
+		tail = head.get();
+	}
+	else {
+		tail->next = std::move(newNode);
+		tail = tail->next.get();
+	}
+	++length;
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::push_back(T &&thedata) {
+	node_ptr newNode = make_node(std::move(thedata));
+	newNode->previous = tail;
+
+	if (!head) {
+		head = std::move(newNode);
+		tail = head.get();
+	}
+
+	else {
+		tail->next = std::move(newNode);
+		tail = tail->next.get();
+	}
+	++length;
+}
+
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::push_front(const T &theData) {
+	head = make_node(std::move(head), nullptr, theData);
+
+	if (head->next) {
+		head->next->previous = head.get();
+	}
+	else {
+		tail = head.get();
+	}
+	++length;
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::push_front(T &&theData) {
+	head = make_node(std::move(head),nullptr,std::move(theData));
+
+	if (head->next) {
+		head->next->previous = head.get();
+	}
+	else {
+		tail = head.get();
+	}
+	++length;
+}
+
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::insert(const_iterator pos, const T& theData) {
+	return emplace(pos, theData);
+}
+
+template <class T, class Allocator>
+typename  DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::insert(const_iterator pos, T&& theData) {
+	return emplace(pos, std::move(theData));
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("List is Empty!!! Deletion is not possible.");
+	}
+
+	do_pop_front();
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::pop_back() {
+	if (!head) {
+		return;
+	}
+
+	if (tail == head.get()) {
+		do_pop_front();
+		return;
+	}
+
+	tail = tail->previous;
+	tail->next = nullptr;
+	--length;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::erase(const_iterator pos) {
+	if (pos.end_reached) {
+		pop_back();
+		return end();
+	}
+
+	if (!pos.node) {
+		return end();
+	}
+
+	if (pos.node == head.get()) {
+		do_pop_front();
+		return begin();
+	}
+
+	// The predecessor owns pos, so handing it pos->next frees the node
+	Node* prev = pos.node->previous;
+	Node* next = pos.node->next.get();
+	if (next) next->previous = prev;
+	else tail = prev;
+	prev->next = std::move(pos.node->next);
+	--length;
+
+	return next ? iterator{ next } : end();
+}
+
+template <class T, class Allocator>
+bool DoubleLinkedList<T, Allocator>::search(const T &x) {
+	return detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&x](const Node* node) { return node->data == x; }) != nullptr;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::size_type DoubleLinkedList<T, Allocator>::count(const T &x) const {
+	return static_cast<size_type>(std::count(begin(), end(), x));
+}
+
+template <class T, class Allocator>
+template <typename Predicate>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::find_if(Predicate pred) {
+	return std::find_if(begin(), end(), pred);
+}
+
+// Calls f on every element in order, prefetching Distance nodes ahead, see Prefetch.h
+template <class T, class Allocator>
+template <std::size_t Distance, typename Function>
+void DoubleLinkedList<T, Allocator>::for_each(Function f) {
+	detail::find_prefetched<Distance>(head.get(), next_of, [&f](Node* node) { f(node->data); return false; });
+}
+
+template <class T, class Allocator>
+template <std::size_t Distance, typename Function>
+void DoubleLinkedList<T, Allocator>::for_each(Function f) const {
+	detail::find_prefetched<Distance>(head.get(), next_of, [&f](const Node* node) { f(static_cast<const T&>(node->data)); return false; });
+}
+
+// One pass over the chain, each element is checked against all of the keys at once
+template <class T, class Allocator>
+template <typename InputIt>
+bool DoubleLinkedList<T, Allocator>::contains_any(InputIt first, InputIt last) const {
+	const std::vector<T> keys(first, last);
+	const T* keys_begin = keys.data();
+	const T* keys_end = keys_begin + keys.size();
+	if (keys_begin == keys_end) return false;
+
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		if (simd::find(keys_begin, keys_end, current->data) != keys_end) return true;
+	}
+	return false;
+}
+
+// One pass over the chain for all of the keys, see KeySet.h. The walk stops early once
+// every key has been found. Returns, per key in the order given, whether it is in the list
+template <class T, class Allocator>
+template <typename InputIt>
+std::vector<bool> DoubleLinkedList<T, Allocator>::search_many(InputIt first, InputIt last) const {
+	detail::KeySet<T> keys(first, last);
+	if (!keys.done()) {
+		detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&keys](const Node* node) { return keys.mark(node->data); });
+	}
+	return keys.found();
+}
+
+// Every element pred accepts, in list order
+template <class T, class Allocator>
+template <typename Predicate>
+std::vector<typename DoubleLinkedList<T, Allocator>::iterator> DoubleLinkedList<T, Allocator>::find_all(Predicate pred) {
+	std::vector<iterator> matches;
+	detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&](Node* node) {
+		if (pred(node->data)) matches.push_back(iterator{ node });
+		return false;
+	});
+	return matches;
+}
+
+// Moves the nodes of the sorted chain second into the sorted chain first. Runs that are
+// already in order are skipped without writing a link, and first wins ties so the merge
+// is stable. Back pointers are kept up to date, tail is left to the caller. If comp
+// throws every node is still owned by one of the two chains.
+template <class T, class Allocator>
+template <typename Compare>
+void DoubleLinkedList<T, Allocator>::merge_chains(node_ptr &first, node_ptr &second, Compare &comp) {
+	Node* previous = nullptr;
+	node_ptr* link = &first;
+	while (*link && second) {
+		if (comp(second->data, (*link)->data)) {
+			node_ptr node = std::move(second);
+			second = std::move(node->next);
+			node->next = std::move(*link);
+			node->next->previous = node.get();
+			node->previous = previous;
+			*link = std::move(node);
+		}
+		previous = link->get();
+		link = &(*link)->next;
+	}
+	if (second) {
+		second->previous = previous;
+		*link = std::move(second);
+	}
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::append_chain(node_ptr &chain, node_ptr &&rest) noexcept {
+	node_ptr* link = &chain;
+	while (*link) link = &(*link)->next;
+	*link = std::move(rest);
+}
+
+// Walks the chain once to fix tail and the back pointers after nodes got relinked
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::restore_links() noexcept {
+	Node* previous = nullptr;
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		current->previous = previous;
+		previous = current;
+	}
+	tail = previous;
+}
+
+// Bottom-up merge sort that only relinks nodes: no allocation, no element moves and
+// no recursion. bins[i] is empty or holds a sorted run of 2^i nodes, so 64 bins cover
+// any list that fits in memory. If comp throws the list keeps all of its elements in
+// an unspecified order.
+template <class T, class Allocator>
+template <typename Compare>
+void DoubleLinkedList<T, Allocator>::sort(Compare comp) {
+	if (!head || !head->next) return;
+
+	node_ptr bins[64];
+	node_ptr rest = std::move(head);
+	node_ptr carry;
+
+	try {
+		while (rest) {
+			carry = std::move(rest);
+			rest = std::move(carry->next);
+
+			std::size_t i = 0;
+			for (; bins[i]; ++i) {
+				merge_chains(bins[i], carry, comp);		// bins[i] holds the earlier elements
+				carry = std::move(bins[i]);
+			}
+			bins[i] = std::move(carry);
+		}
+
+		for (auto& bin : bins) {
+			if (!bin) continue;
+			merge_chains(bin, carry, comp);
+			carry = std::move(bin);
+		}
+		head = std::move(carry);
+	}
+	catch (...) {
+		head = std::move(rest);
+		append_chain(head, std::move(carry));
+		for (auto& bin : bins) append_chain(head, std::move(bin));
+		restore_links();
+		throw;
+	}
+	restore_links();
+}
+
+// Merges the sorted other into this sorted list and leaves other empty. The allocators
+// have to compare equal, as for std::list::merge.
+template <class T, class Allocator>
+template <typename Compare>
+void DoubleLinkedList<T, Allocator>::merge(DoubleLinkedList &other, Compare comp) {
+	if (&other == this || !other.head) return;
+
+	try {
+		merge_chains(head, other.head, comp);
+	}
+	catch (...) {
+		length = count_nodes();
+		other.length = other.count_nodes();
+		restore_links();
+		other.restore_links();
+		throw;
+	}
+	if (!tail || tail->next) tail = other.tail;		// the last node came from other
+	length += other.length;
+	other.length = 0;
+	other.tail = nullptr;
+}
+
+template <class T, class Allocator>
+template <typename Compare>
+void DoubleLinkedList<T, Allocator>::merge(DoubleLinkedList &&other, Compare comp) {
+	merge(other, std::move(comp));
+}
+
+// Takes the nodes first through last out of the list and hands back the chain that owns them
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::node_ptr DoubleLinkedList<T, Allocator>::unlink(Node* first, Node* last) noexcept {
+	Node* prev = first->previous;
+	node_ptr& link = prev ? prev->next : head;
+	node_ptr chain = std::move(link);
+	link = std::move(last->next);
+
+	if (link) link->previous = prev;
+	else tail = prev;
+	return chain;
+}
+
+// Links a chain that ends in last in front of pos, or at the back if pos is null
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::link_before(Node* pos, node_ptr chain, Node* last) noexcept {
+	if (!pos) {
+		chain->previous = tail;
+		node_ptr& link = tail ? tail->next : head;
+		link = std::move(chain);
+		tail = last;
+		return;
+	}
+
+	Node* prev = pos->previous;
+	chain->previous = prev;
+	node_ptr& link = prev ? prev->next : head;
+	last->next = std::move(link);
+	pos->previous = last;
+	link = std::move(chain);
+}
+
+// The splice overloads move nodes from other in front of pos without touching the
+// elements, so iterators to them stay valid and now point into this list. As with
+// std::list the allocators have to compare equal.
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::splice(const_iterator pos, DoubleLinkedList &other) noexcept {
+	if (&other == this || !other.head) return;
+
+	Node* last = other.tail;
+	link_before(node_at(pos), std::move(other.head), last);
+	length += other.length;
+	other.tail = nullptr;
+	other.length = 0;
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::splice(const_iterator pos, DoubleLinkedList &&other) noexcept {
+	splice(pos, other);
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::splice(const_iterator pos, DoubleLinkedList &other, const_iterator it) noexcept {
+	Node* node = node_at(it);
+	Node* before = node_at(pos);
+	if (!node || node == before || (before && node->next.get() == before) || (!before && &other == this && node == tail)) return;
+
+	link_before(before, other.unlink(node, node), node);
+	++length;
+	--other.length;
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::splice(const_iterator pos, DoubleLinkedList &&other, const_iterator it) noexcept {
+	splice(pos, other, it);
+}
+
+// Moves [first, last), counting the range makes it linear unless other is this list
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::splice(const_iterator pos, DoubleLinkedList &other, const_iterator first, const_iterator last) noexcept {
+	Node* begin_node = node_at(first);
+	Node* end_node = node_at(last);
+	if (!begin_node || begin_node == end_node) return;
+
+	Node* last_node = end_node ? end_node->previous : other.tail;
+	if (&other != this) {
+		std::size_t moved = 1;
+		for (Node* node = begin_node; node != last_node; node = node->next.get()) ++moved;
+		length += moved;
+		other.length -= moved;
+	}
+	else if (node_at(pos) == end_node) {
+		return;		// already in place
+	}
+
+	link_before(node_at(pos), other.unlink(begin_node, last_node), last_node);
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::splice(const_iterator pos, DoubleLinkedList &&other, const_iterator first, const_iterator last) noexcept {
+	splice(pos, other, first, last);
+}
+
+// Allocates and links the nodes for [first, last) without touching the list. Nothing
+// leaks if an element throws, and the chain is freed node by node so a long one can
+// not overflow the stack. A forward range is read with prefetching, see Prefetch.h.
+template <class T, class Allocator>
+template <typename InputIt>
+typename DoubleLinkedList<T, Allocator>::node_ptr DoubleLinkedList<T, Allocator>::build_chain(InputIt first, InputIt last, Node* &chain_tail, std::size_t &built) {
+	node_ptr chain;
+	node_ptr* link = &chain;
+	Node* previous = nullptr;
+	built = 0;
+
+	try {
+		detail::for_each_prefetched<detail::prefetch_distance>(first, last, [&](auto&& item) {
+			*link = make_node(std::forward<decltype(item)>(item));
+			(*link)->previous = previous;
+			previous = link->get();
+			link = &previous->next;
+			++built;
+		});
+	}
+	catch (...) {
+		free_chain(std::move(chain));
+		throw;
+	}
+	chain_tail = previous;
+	return chain;
+}
+
+// Walks the chain with raw pointers, an allocator that can take the whole
+// chain back in one call gets it that way
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::free_chain(node_ptr chain) noexcept {
+	NodeDeleter deleter = chain.get_deleter();
+	Node* current = chain.release();
+
+	if constexpr (detail::has_deallocate_chain<node_allocator>::value) {
+		deleter.deallocate_chain(current, [&deleter](Node* node) noexcept {
+			Node* next = node->next.release();
+			if constexpr (!std::is_trivially_destructible<T>::value) node_traits::destroy(deleter, node);
+			return next;
+		});
+	}
+	else {
+		while (current) {
+			Node* next = current->next.release();
+			deleter(current);
+			current = next;
+		}
+	}
+}
+
+// Frees every node after last_kept, or all of them if it is null
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::truncate(Node* last_kept, std::size_t kept) noexcept {
+	node_ptr& rest = last_kept ? last_kept->next : head;
+	free_chain(std::move(rest));
+	tail = last_kept;
+	length = kept;
+}
+
+// Reuses the nodes already in the list, then appends or drops the difference
+template <class T, class Allocator>
+template <typename InputIt, typename>
+void DoubleLinkedList<T, Allocator>::assign(InputIt first, InputIt last) {
+	Node* previous = nullptr;
+	size_type kept = 0;
+	for (Node* current = head.get(); current != nullptr && first != last; current = current->next.get(), ++first) {
+		current->data = *first;
+		previous = current;
+		++kept;
+	}
+
+	if (first != last) append_range(first, last);
+	else truncate(previous, kept);
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::assign(size_type count, const T &value) {
+	Node* previous = nullptr;
+	size_type kept = 0;
+	for (Node* current = head.get(); current != nullptr && kept < count; current = current->next.get()) {
+		current->data = value;
+		previous = current;
+		++kept;
+	}
+	if (kept == count) {
+		truncate(previous, kept);
+		return;
+	}
+
+	node_ptr chain;
+	node_ptr* link = &chain;
+	Node* chain_tail = nullptr;
+	try {
+		for (size_type i = kept; i < count; ++i) {
+			*link = make_node(value);
+			(*link)->previous = chain_tail;
+			chain_tail = link->get();
+			link = &chain_tail->next;
+		}
+	}
+	catch (...) {
+		free_chain(std::move(chain));
+		throw;
+	}
+	link_before(nullptr, std::move(chain), chain_tail);
+	length = count;
+}
+
+template <class T, class Allocator>
+void DoubleLinkedList<T, Allocator>::assign(std::initializer_list<T> init) {
+	assign(init.begin(), init.end());
+}
+
+// Builds the new nodes as one chain and links it in front of pos once, returns the
+// first one inserted
+template <class T, class Allocator>
+template <typename InputIt, typename>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::insert_range(const_iterator pos, InputIt first, InputIt last) {
+	Node* chain_tail = nullptr;
+	std::size_t built = 0;
+	node_ptr chain = build_chain(first, last, chain_tail, built);
+	if (!chain) return { pos.node, pos.end_reached };
+
+	Node* chain_head = chain.get();
+	link_before(node_at(pos), std::move(chain), chain_tail);
+	length += built;
+	return { chain_head };
+}
+
+template <class T, class Allocator>
+template <typename InputIt, typename>
+void DoubleLinkedList<T, Allocator>::append_range(InputIt first, InputIt last) {
+	insert_range(cend(), first, last);
+}
+
+template <class T, class Allocator>
+std::ostream& operator<<(std::ostream &str, DoubleLinkedList<T, Allocator>& list) {
+	list.for_each([&str](const T& item) { str << item << "\t"; });
+	return str;
+}
+
+
+// Iterator Implementaion////////////////////////////////////////////////
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator& DoubleLinkedList<T, Allocator>::iterator::operator++() {
+	if (!node) return *this;
+
+	if (node->next) {
+		node = node->next.get();
+	}
+	
+	else {
+		end_reached = true;			// keep last node, so we can go backwards if required
+	}
+
+	return *this;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator& DoubleLinkedList<T, Allocator>::iterator::operator--() {
+	if (!node) return *this;
+
+	if (end_reached) {
+		end_reached = false;
+	}
+
+	else if (node->previous) {
+		node = node->previous;
+	}
+
+	return *this;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::iterator::operator--(int) {
+	auto copy = *this;
+	--*this;
+	return copy;
+}
+
+template <class T, class Allocator>
+bool DoubleLinkedList<T, Allocator>::iterator::operator==(iterator other) const noexcept {
+	if (end_reached) return other.end_reached;
+	
+	if (other.end_reached) return false;
+
+	return node == other.node;
+}
+
+template <class T, class Allocator>
+bool DoubleLinkedList<T, Allocator>::iterator::operator!=(iterator other) const noexcept {
+	return !(*this == other);
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::begin() {
+	return { head.get(), !head };
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::end() {
+	return {tail, true};
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::iterator DoubleLinkedList<T, Allocator>::before_begin() {
+	return { head.get(), false };
+}
+
+// Const Iterator Implementaion////////////////////////////////////////////////
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator& DoubleLinkedList<T, Allocator>::const_iterator::operator++() {
+	if (!node) return *this;
+
+	if (node->next) {
+		node = node->next.get();
+	}
+
+	else {
+		end_reached = true;			// keep last node, so we can go backwards if required
+	}
+
+	return *this;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::const_iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator& DoubleLinkedList<T, Allocator>::const_iterator::operator--() {
+	if (!node) return *this;
+
+	if (end_reached) {
+		end_reached = false;
+	}
+
+	else if (node->previous) {
+		node = node->previous;
+	}
+
+	return *this;
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::const_iterator::operator--(int) {
+	auto copy = *this;
+	--*this;
+	return copy;
+}
+
+template <class T, class Allocator>
+bool DoubleLinkedList<T, Allocator>::const_iterator::operator==(const_iterator other) const noexcept {
+	if (end_reached) return other.end_reached;
+
+	if (other.end_reached) return false;
+
+	return node == other.node;
+}
+
+template <class T, class Allocator>
+bool DoubleLinkedList<T, Allocator>::const_iterator::operator!=(const_iterator other) const noexcept {
+	return !(*this == other);
+}
+
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::begin() const {
+	return { head.get(), !head };
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::end() const {
+	return {tail, true};
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::cbegin() const {
+	return begin();
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::cend() const {
+	return end();
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::before_begin() const {
+	return { head.get(), true };
+}
+
+template <class T, class Allocator>
+typename DoubleLinkedList<T, Allocator>::const_iterator DoubleLinkedList<T, Allocator>::cbefore_begin() const {
+	return before_begin();
+}
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+//
+//  EpochReclamation.h
+//  Data Structure - LinkedList
+//
+// Epoch based reclamation for the lock-free containers. A reader pins the
+// current epoch for as long as it may hold pointers into a shared structure;
+// a writer that unlinks a node retires it instead of deleting it, and the node
+// is freed once the global epoch has moved two steps past the retirement,
+// when no pinned reader can still see it.
+//
+// One domain serves the whole process. Every thread gets a record the first
+// time it pins; records are recycled when threads exit and never freed.
+//
+
+#ifndef EPOCHRECLAMATION_h
+#define EPOCHRECLAMATION_h
+
+
+namespace detail {
+
+class EpochDomain {
+public:
+	struct Retired {
+		void* object;
+		void (*destroy)(void*);
+	};
+
+	struct Record {
+		std::atomic<std::uint64_t> state{ 0 };		// (epoch << 1) | pinned
+		std::atomic<bool> in_use{ false };
+		Record* next = nullptr;						// registry link, fixed once published
+
+		// Only touched by the owning thread
+		unsigned nesting = 0;
+		std::size_t retired_since_advance = 0;
+		std::vector<Retired> limbo[3];
+		std::uint64_t limbo_epoch[3] = {};
+	};
+
+	static EpochDomain& instance() {
+		static EpochDomain* domain = new EpochDomain;		// never destroyed, threads may retire during exit
+		return *domain;
+	}
+
+	static Record& local();
+
+	void pin(Record& record);
+	void unpin(Record& record) noexcept;
+	void retire(Record& record, void* object, void (*destroy)(void*));
+
+	std::uint64_t epoch() const noexcept { return global.load(std::memory_order_acquire); }
+
+private:
+	// How many retirements a thread makes before it tries to move the epoch on
+	static constexpr std::size_t advance_interval = 64;
+
+	std::atomic<std::uint64_t> global{ 0 };
+	std::atomic<Record*> records{ nullptr };
+
+	struct Handle {
+		Record* record = nullptr;
+		~Handle();
+	};
+
+	Record* acquire_record();
+	bool try_advance() noexcept;
+	static void free_bag(std::vector<Retired>& bag) noexcept;
+	void collect(Record& record, std::uint64_t now) noexcept;
+};
+
+inline EpochDomain::Handle::~Handle() {
+	if (record) record->in_use.store(false, std::memory_order_release);
+	record = nullptr;
+}
+
+inline EpochDomain::Record& EpochDomain::local() {
+	thread_local Handle handle;
+	if (!handle.record) handle.record = instance().acquire_record();
+	return *handle.record;
+}
+
+inline EpochDomain::Record* EpochDomain::acquire_record() {
+	for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+		bool expected = false;
+		if (!record->in_use.load(std::memory_order_relaxed)
+			&& record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+			return record;
+		}
+	}
+
+	Record* record = new Record;
+	record->in_use.store(true, std::memory_order_relaxed);
+	Record* first = records.load(std::memory_order_relaxed);
+	do {
+		record->next = first;
+	} while (!records.compare_exchange_weak(first, record, std::memory_order_release, std::memory_order_relaxed));
+	return record;
+}
+
+inline void EpochDomain::pin(Record& record) {
+	if (record.nesting++ > 0) return;
+
+	const std::uint64_t now = global.load(std::memory_order_relaxed);
+	record.state.store((now << 1) | 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	collect(record, global.load(std::memory_order_acquire));
+}
+
+inline void EpochDomain::unpin(Record& record) noexcept {
+	if (--record.nesting > 0) return;
+	record.state.store(0, std::memory_order_release);
+}
+
+inline void EpochDomain::retire(Record& record, void* object, void (*destroy)(void*)) {
+	const std::uint64_t now = global.load(std::memory_order_acquire);
+	const std::size_t slot = now % 3;
+
+	// A bag still tagged with an older epoch is at least three epochs old
+	if (record.limbo_epoch[slot] != now) {
+		free_bag(record.limbo[slot]);
+		record.limbo_epoch[slot] = now;
+	}
+	record.limbo[slot].push_back({ object, destroy });
+
+	if (++record.retired_since_advance >= advance_interval) {
+		record.retired_since_advance = 0;
+		if (try_advance()) collect(record, global.load(std::memory_order_acquire));
+	}
+}
+
+// The epoch moves on only when every pinned thread has seen the current one
+inline bool EpochDomain::try_advance() noexcept {
+	std::uint64_t now = global.load(std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	for (Record* record = records.load(std::memory_order_acquire); record; record = record->next) {
+		const std::uint64_t state = record->state.load(std::memory_order_acquire);
+		if ((state & 1) && (state >> 1) != now) return false;
+	}
+
+	// Losing the race means another thread has advanced it already
+	global.compare_exchange_strong(now, now + 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+	return true;
+}
+
+inline void EpochDomain::free_bag(std::vector<Retired>& bag) noexcept {
+	for (const Retired& retired : bag) retired.destroy(retired.object);
+	bag.clear();
+}
+
+inline void EpochDomain::collect(Record& record, std::uint64_t now) noexcept {
+	for (std::size_t slot = 0; slot < 3; ++slot) {
+		if (!record.limbo[slot].empty() && record.limbo_epoch[slot] + 2 <= now) {
+			free_bag(record.limbo[slot]);
+		}
+	}
+}
+
+} // namespace detail
+
+
+// Keeps the calling thread pinned to the current epoch while it is alive
+class EpochGuard {
+	detail::EpochDomain::Record& record;
+
+public:
+	EpochGuard() : record{ detail::EpochDomain::local() } { detail::EpochDomain::instance().pin(record); }
+	~EpochGuard() { detail::EpochDomain::instance().unpin(record); }
+
+	EpochGuard(const EpochGuard&) = delete;
+	EpochGuard& operator=(const EpochGuard&) = delete;
+
+	// Frees object with delete once no pinned thread can reach it any more
+	template <class U>
+	void retire(U* object) {
+		detail::EpochDomain::instance().retire(record, object, [](void* p) { delete static_cast<U*>(p); });
+	}
+};
+
+#endif
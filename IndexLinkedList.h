@@ -0,0 +1,671 @@
+//
+//  IndexLinkedList.h
+//  Data Structure - LinkedList
+//
+// A doubly linked list in struct-of-arrays form. The elements, the next links
+// and the previous links are three parallel vectors, and a link is the index
+// of a slot in them. Erased slots are chained into a free list and reused by
+// the next insertion, so inserting and erasing at a known position stay O(1).
+//
+// search(), count() and contains_any() don't follow the links at all. They
+// scan the element vector from front to back, with the SIMD kernels for
+// arithmetic types, and then discount the free slots. compact() moves the
+// elements into list order and drops the free slots, after which walking
+// the list is a walk over contiguous memory as well.
+//
+// Iterators hold a slot index, so they stay valid while other elements are
+// inserted and erased. Pointers and references to elements are invalidated
+// whenever the vectors grow. compact() invalidates both.
+//
+
+#ifndef INDEXLINKEDLIST_h
+#define INDEXLINKEDLIST_h
+
+#include "SimdSearch.h"
+
+
+template <class T, class Allocator = std::allocator<T>>
+class IndexLinkedList {
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using index_type = std::uint32_t;
+
+private:
+	using index_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<index_type>;
+
+	static constexpr index_type npos = ~index_type(0);
+	static constexpr index_type free_mark = npos - 1;		// in previous_links, marks a slot on the free list
+
+	template <typename InputIt>
+	using RequireInputIterator = std::enable_if_t<std::is_convertible<
+		typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>::value>;
+
+	std::vector<T, Allocator> values;
+	std::vector<index_type, index_allocator> next_links;
+	std::vector<index_type, index_allocator> previous_links;
+	index_type head = npos;
+	index_type tail = npos;
+	index_type free_head = npos;		// free slots, chained through next_links
+	std::size_t length = 0;
+
+	template <typename... Args>
+	index_type make_slot(Args&&... args);
+	void free_slot(index_type index) noexcept;
+	void link_range_before(index_type pos, index_type first, index_type last) noexcept;
+	void unlink_range(index_type first, index_type last) noexcept;
+	void relink(const std::vector<index_type> &order) noexcept;
+	std::vector<index_type> list_order() const;
+
+public:
+	IndexLinkedList() = default;											// empty constructor
+	explicit IndexLinkedList(const Allocator &alloc);						// empty constructor with allocator
+	IndexLinkedList(IndexLinkedList const &source) = default;				// copy constructor, copies the free slots too
+	IndexLinkedList(size_type count, const T &value, const Allocator &alloc = Allocator());
+	IndexLinkedList(std::initializer_list<T> init, const Allocator &alloc = Allocator());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	IndexLinkedList(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+
+																			// Rule of 5
+	IndexLinkedList(IndexLinkedList &&move) noexcept;						// move constructor
+	IndexLinkedList& operator=(IndexLinkedList &&move) noexcept;			// move assignment operator
+	~IndexLinkedList() = default;
+
+	// Overload operators
+	IndexLinkedList& operator=(IndexLinkedList const &rhs) = default;
+	IndexLinkedList& operator=(std::initializer_list<T> init);
+
+	// Create an iterator class
+	class iterator;
+	iterator begin() noexcept { return { this, head }; }
+	iterator end() noexcept { return { this, npos }; }
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator cbegin() const noexcept { return { this, head }; }
+	const_iterator cend() const noexcept { return { this, npos }; }
+	const_iterator begin() const noexcept { return cbegin(); }
+	const_iterator end() const noexcept { return cend(); }
+
+	// Reverse iteator
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	reverse_iterator rbegin() noexcept { return reverse_iterator{ end() }; }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{ end() }; }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator{ end() }; }
+
+	reverse_iterator rend() noexcept { return reverse_iterator{ begin() }; }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator{ begin() }; }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator{ begin() }; }
+
+	// Memeber functions
+	void swap(IndexLinkedList &other) noexcept;
+	allocator_type get_allocator() const { return values.get_allocator(); }
+	bool empty() const noexcept { return length == 0; }
+	size_type size() const noexcept { return length; }
+	size_type capacity() const noexcept { return values.capacity(); }
+	void reserve(size_type count);
+
+	// Moves the elements into list order and releases the free slots
+	void compact();
+
+	template<typename... Args>
+	void emplace_back(Args&&... args);
+
+	template<typename... Args>
+	void emplace_front(Args&&... args);
+
+	template<typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args);
+
+	void push_back(const T &theData);
+	void push_back(T &&theData);
+	void push_front(const T &theData);
+	void push_front(T &&theData);
+	iterator insert(const_iterator pos, const T& theData);
+	iterator insert(const_iterator pos, T&& theData);
+	void clear() noexcept;
+	void pop_front();
+	void pop_back();
+	iterator erase(const_iterator pos);
+	bool search(const T &x) const;
+	size_type count(const T &x) const;
+
+	template<typename Predicate>
+	iterator find_if(Predicate pred);
+
+	template<typename InputIt>
+	bool contains_any(InputIt first, InputIt last) const;
+
+	template<typename Compare = std::less<T>>
+	void sort(Compare comp = Compare());
+
+	template<typename Compare = std::less<T>>
+	void merge(IndexLinkedList &other, Compare comp = Compare());
+
+	template<typename Compare = std::less<T>>
+	void merge(IndexLinkedList &&other, Compare comp = Compare());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	void assign(InputIt first, InputIt last);
+	void assign(size_type count, const T &value);
+	void assign(std::initializer_list<T> init);
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	iterator insert_range(const_iterator pos, InputIt first, InputIt last);
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	void append_range(InputIt first, InputIt last);
+
+	// Within one list these only relink, between two lists the elements are moved over
+	void splice(const_iterator pos, IndexLinkedList &other);
+	void splice(const_iterator pos, IndexLinkedList &&other);
+	void splice(const_iterator pos, IndexLinkedList &other, const_iterator it);
+	void splice(const_iterator pos, IndexLinkedList &&other, const_iterator it);
+	void splice(const_iterator pos, IndexLinkedList &other, const_iterator first, const_iterator last);
+	void splice(const_iterator pos, IndexLinkedList &&other, const_iterator first, const_iterator last);
+};
+
+template <class T, class Allocator>
+class IndexLinkedList<T, Allocator>::iterator {
+	IndexLinkedList* list = nullptr;
+	index_type index = npos;
+
+public:
+	friend class IndexLinkedList<T, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T * ;
+	using reference = T & ;
+
+	iterator() = default;
+	iterator(IndexLinkedList* list, index_type index) : list{ list }, index{ index } {}
+
+	operator const_iterator() const noexcept { return const_iterator{ list, index }; }
+	bool operator!=(iterator other) const noexcept { return index != other.index; }
+	bool operator==(iterator other) const noexcept { return index == other.index; }
+
+	T& operator*() const { return list->values[index]; }
+	T* operator->() const { return &list->values[index]; }
+
+	iterator& operator++() { index = list->next_links[index]; return *this; }
+	iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+	iterator& operator--() { index = index == npos ? list->tail : list->previous_links[index]; return *this; }
+	iterator operator--(int) { auto copy = *this; --*this; return copy; }
+};
+
+template <class T, class Allocator>
+class IndexLinkedList<T, Allocator>::const_iterator {
+	const IndexLinkedList* list = nullptr;
+	index_type index = npos;
+
+public:
+	friend class IndexLinkedList<T, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T * ;
+	using reference = const T & ;
+
+	const_iterator() = default;
+	const_iterator(const IndexLinkedList* list, index_type index) : list{ list }, index{ index } {}
+
+	bool operator!=(const_iterator other) const noexcept { return index != other.index; }
+	bool operator==(const_iterator other) const noexcept { return index == other.index; }
+
+	const T& operator*() const { return list->values[index]; }
+	const T* operator->() const { return &list->values[index]; }
+
+	const_iterator& operator++() { index = list->next_links[index]; return *this; }
+	const_iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+	const_iterator& operator--() { index = index == npos ? list->tail : list->previous_links[index]; return *this; }
+	const_iterator operator--(int) { auto copy = *this; --*this; return copy; }
+};
+
+
+template <class T, class Allocator>
+IndexLinkedList<T, Allocator>::IndexLinkedList(const Allocator &alloc)
+	: values(alloc), next_links(index_allocator{ alloc }), previous_links(index_allocator{ alloc }) {}
+
+template <class T, class Allocator>
+IndexLinkedList<T, Allocator>::IndexLinkedList(size_type count, const T &value, const Allocator &alloc) : IndexLinkedList(alloc) {
+	assign(count, value);
+}
+
+template <class T, class Allocator>
+IndexLinkedList<T, Allocator>::IndexLinkedList(std::initializer_list<T> init, const Allocator &alloc) : IndexLinkedList(alloc) {
+	append_range(init.begin(), init.end());
+}
+
+template <class T, class Allocator>
+template <typename InputIt, typename>
+IndexLinkedList<T, Allocator>::IndexLinkedList(InputIt first, InputIt last, const Allocator &alloc) : IndexLinkedList(alloc) {
+	append_range(first, last);
+}
+
+template <class T, class Allocator>
+IndexLinkedList<T, Allocator>::IndexLinkedList(IndexLinkedList &&move) noexcept
+	: values(std::move(move.values)), next_links(std::move(move.next_links)), previous_links(std::move(move.previous_links))
+	, head{ move.head }, tail{ move.tail }, free_head{ move.free_head }, length{ move.length } {
+	move.values.clear();
+	move.next_links.clear();
+	move.previous_links.clear();
+	move.head = move.tail = move.free_head = npos;
+	move.length = 0;
+}
+
+template <class T, class Allocator>
+IndexLinkedList<T, Allocator>& IndexLinkedList<T, Allocator>::operator=(IndexLinkedList &&move) noexcept {
+	move.swap(*this);
+	return *this;
+}
+
+template <class T, class Allocator>
+IndexLinkedList<T, Allocator>& IndexLinkedList<T, Allocator>::operator=(std::initializer_list<T> init) {
+	assign(init.begin(), init.end());
+	return *this;
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::swap(IndexLinkedList &other) noexcept {
+	using std::swap;
+	values.swap(other.values);
+	next_links.swap(other.next_links);
+	previous_links.swap(other.previous_links);
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(free_head, other.free_head);
+	swap(length, other.length);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::reserve(size_type count) {
+	if (count > free_mark) throw std::length_error("IndexLinkedList is out of 32 bit indices");
+	values.reserve(count);
+	next_links.reserve(count);
+	previous_links.reserve(count);
+}
+
+// A free slot if there is one, otherwise a new one at the end of the vectors. The
+// slot is not linked yet, and nothing changes if constructing the element throws.
+template <class T, class Allocator>
+template <typename... Args>
+typename IndexLinkedList<T, Allocator>::index_type IndexLinkedList<T, Allocator>::make_slot(Args&&... args) {
+	if (free_head != npos) {
+		const index_type index = free_head;
+		values[index] = T(std::forward<Args>(args)...);
+		free_head = next_links[index];
+		return index;
+	}
+
+	const std::size_t slots = values.size();
+	if (slots == free_mark) throw std::length_error("IndexLinkedList is out of 32 bit indices");
+	if (slots == next_links.capacity() || slots == previous_links.capacity()) {
+		const std::size_t grown = slots < 8 ? 16 : 2 * slots;
+		next_links.reserve(grown);
+		previous_links.reserve(grown);
+	}
+	values.emplace_back(std::forward<Args>(args)...);
+	next_links.push_back(npos);				// cannot throw, the capacity is there
+	previous_links.push_back(npos);
+	return static_cast<index_type>(slots);
+}
+
+// The element is left moved from, which lets go of whatever it owned
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::free_slot(index_type index) noexcept {
+	if constexpr (!std::is_trivially_destructible<T>::value) {
+		T released{ std::move(values[index]) };
+	}
+	previous_links[index] = free_mark;
+	next_links[index] = free_head;
+	free_head = index;
+}
+
+// Links the chain first..last, whose inner links are already set, in front of pos
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::link_range_before(index_type pos, index_type first, index_type last) noexcept {
+	const index_type before = pos == npos ? tail : previous_links[pos];
+	previous_links[first] = before;
+	next_links[last] = pos;
+	if (before != npos) next_links[before] = first;
+	else head = first;
+	if (pos != npos) previous_links[pos] = last;
+	else tail = last;
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::unlink_range(index_type first, index_type last) noexcept {
+	const index_type before = previous_links[first];
+	const index_type after = next_links[last];
+	if (before != npos) next_links[before] = after;
+	else head = after;
+	if (after != npos) previous_links[after] = before;
+	else tail = before;
+}
+
+// Links the slots in order as the whole list
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::relink(const std::vector<index_type> &order) noexcept {
+	index_type previous = npos;
+	for (index_type index : order) {
+		previous_links[index] = previous;
+		if (previous != npos) next_links[previous] = index;
+		previous = index;
+	}
+	head = order.empty() ? npos : order.front();
+	tail = previous;
+	if (tail != npos) next_links[tail] = npos;
+}
+
+template <class T, class Allocator>
+std::vector<typename IndexLinkedList<T, Allocator>::index_type> IndexLinkedList<T, Allocator>::list_order() const {
+	std::vector<index_type> order;
+	order.reserve(length);
+	for (index_type index = head; index != npos; index = next_links[index]) order.push_back(index);
+	return order;
+}
+
+// Builds the packed vectors next to the old ones. Everything is allocated before the first
+// element moves, and elements whose move may throw are copied instead, so if anything throws
+// the list is left as it was
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::compact() {
+	std::vector<index_type, index_allocator> next(length, npos, next_links.get_allocator());
+	std::vector<index_type, index_allocator> previous(length, npos, previous_links.get_allocator());
+	for (std::size_t i = 0; i < length; ++i) {
+		if (i + 1 < length) next[i] = static_cast<index_type>(i + 1);
+		if (i > 0) previous[i] = static_cast<index_type>(i - 1);
+	}
+
+	std::vector<T, Allocator> packed(values.get_allocator());
+	packed.reserve(length);
+	for (index_type index = head; index != npos; index = next_links[index]) packed.push_back(std::move_if_noexcept(values[index]));
+
+	values.swap(packed);
+	next_links.swap(next);
+	previous_links.swap(previous);
+	head = length ? 0 : npos;
+	tail = length ? static_cast<index_type>(length - 1) : npos;
+	free_head = npos;
+}
+
+template <class T, class Allocator>
+template <typename... Args>
+void IndexLinkedList<T, Allocator>::emplace_back(Args&&... args) {
+	emplace(cend(), std::forward<Args>(args)...);
+}
+
+template <class T, class Allocator>
+template <typename... Args>
+void IndexLinkedList<T, Allocator>::emplace_front(Args&&... args) {
+	emplace(cbegin(), std::forward<Args>(args)...);
+}
+
+template <class T, class Allocator>
+template <typename... Args>
+typename IndexLinkedList<T, Allocator>::iterator IndexLinkedList<T, Allocator>::emplace(const_iterator pos, Args&&... args) {
+	const index_type index = make_slot(std::forward<Args>(args)...);
+	link_range_before(pos.index, index, index);
+	++length;
+	return { this, index };
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::push_back(const T &theData) {
+	emplace_back(theData);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::push_back(T &&theData) {
+	emplace_back(std::move(theData));
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::push_front(const T &theData) {
+	emplace_front(theData);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::push_front(T &&theData) {
+	emplace_front(std::move(theData));
+}
+
+template <class T, class Allocator>
+typename IndexLinkedList<T, Allocator>::iterator IndexLinkedList<T, Allocator>::insert(const_iterator pos, const T& theData) {
+	return emplace(pos, theData);
+}
+
+template <class T, class Allocator>
+typename IndexLinkedList<T, Allocator>::iterator IndexLinkedList<T, Allocator>::insert(const_iterator pos, T&& theData) {
+	return emplace(pos, std::move(theData));
+}
+
+// Keeps the capacity, like std::vector::clear
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::clear() noexcept {
+	values.clear();
+	next_links.clear();
+	previous_links.clear();
+	head = tail = free_head = npos;
+	length = 0;
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("List is Empty!!! Deletion is not possible.");
+	}
+	erase(cbegin());
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::pop_back() {
+	if (empty()) {
+		return;
+	}
+	erase(const_iterator{ this, tail });
+}
+
+template <class T, class Allocator>
+typename IndexLinkedList<T, Allocator>::iterator IndexLinkedList<T, Allocator>::erase(const_iterator pos) {
+	if (pos.index == npos) {
+		pop_back();
+		return end();
+	}
+
+	const index_type next = next_links[pos.index];
+	unlink_range(pos.index, pos.index);
+	free_slot(pos.index);
+	--length;
+	return { this, next };
+}
+
+// Scans the element vector, a hit in a free slot doesn't count
+template <class T, class Allocator>
+bool IndexLinkedList<T, Allocator>::search(const T &x) const {
+	const T* first = values.data();
+	const T* last = first + values.size();
+	for (const T* hit = simd::find(first, last, x); hit != last; hit = simd::find(hit + 1, last, x)) {
+		if (previous_links[static_cast<std::size_t>(hit - first)] != free_mark) return true;
+	}
+	return false;
+}
+
+// Counts over the whole element vector, then takes off the matches left in free slots
+template <class T, class Allocator>
+typename IndexLinkedList<T, Allocator>::size_type IndexLinkedList<T, Allocator>::count(const T &x) const {
+	size_type matches = simd::count(values.data(), values.data() + values.size(), x);
+	for (index_type index = free_head; index != npos; index = next_links[index]) {
+		if (values[index] == x) --matches;
+	}
+	return matches;
+}
+
+template <class T, class Allocator>
+template <typename Predicate>
+typename IndexLinkedList<T, Allocator>::iterator IndexLinkedList<T, Allocator>::find_if(Predicate pred) {
+	return std::find_if(begin(), end(), pred);
+}
+
+// One pass over the element vector, each element is checked against all of the keys at once
+template <class T, class Allocator>
+template <typename InputIt>
+bool IndexLinkedList<T, Allocator>::contains_any(InputIt first, InputIt last) const {
+	const std::vector<T> keys(first, last);
+	const T* keys_begin = keys.data();
+	const T* keys_end = keys_begin + keys.size();
+	if (keys_begin == keys_end) return false;
+
+	for (std::size_t index = 0; index < values.size(); ++index) {
+		if (previous_links[index] != free_mark && simd::find(keys_begin, keys_end, values[index]) != keys_end) return true;
+	}
+	return false;
+}
+
+// Sorts the slot order, not the elements, so nothing moves and the links are only
+// rewritten once the sort has succeeded
+template <class T, class Allocator>
+template <typename Compare>
+void IndexLinkedList<T, Allocator>::sort(Compare comp) {
+	if (length < 2) return;
+
+	std::vector<index_type> order = list_order();
+	std::stable_sort(order.begin(), order.end(), [&](index_type a, index_type b) { return comp(values[a], values[b]); });
+	relink(order);
+}
+
+// Moves the elements of the sorted other in at the back, then merges the two runs of
+// slots. Elements of this list come first among equal ones.
+template <class T, class Allocator>
+template <typename Compare>
+void IndexLinkedList<T, Allocator>::merge(IndexLinkedList &other, Compare comp) {
+	if (&other == this || other.empty()) return;
+
+	const std::size_t own = length;
+	reserve(values.size() + other.length);
+	for (T& item : other) emplace_back(std::move(item));
+	other.clear();
+
+	const std::vector<index_type> order = list_order();
+	std::vector<index_type> merged;
+	merged.reserve(order.size());
+	std::merge(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(own), order.begin() + static_cast<std::ptrdiff_t>(own), order.end(),
+		std::back_inserter(merged), [&](index_type a, index_type b) { return comp(values[a], values[b]); });
+	relink(merged);
+}
+
+template <class T, class Allocator>
+template <typename Compare>
+void IndexLinkedList<T, Allocator>::merge(IndexLinkedList &&other, Compare comp) {
+	merge(other, std::move(comp));
+}
+
+template <class T, class Allocator>
+template <typename InputIt, typename>
+void IndexLinkedList<T, Allocator>::assign(InputIt first, InputIt last) {
+	clear();
+	append_range(first, last);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::assign(size_type count, const T &value) {
+	clear();
+	reserve(count);
+	for (size_type i = 0; i < count; ++i) emplace_back(value);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::assign(std::initializer_list<T> init) {
+	assign(init.begin(), init.end());
+}
+
+// Returns the first one inserted. If an element throws, the ones inserted before it are erased again.
+template <class T, class Allocator>
+template <typename InputIt, typename>
+typename IndexLinkedList<T, Allocator>::iterator IndexLinkedList<T, Allocator>::insert_range(const_iterator pos, InputIt first, InputIt last) {
+	index_type inserted = npos;
+	std::size_t built = 0;
+	try {
+		for (; first != last; ++first, ++built) {
+			const index_type index = emplace(pos, *first).index;
+			if (inserted == npos) inserted = index;
+		}
+	}
+	catch (...) {
+		for (; built != 0; --built) inserted = erase(const_iterator{ this, inserted }).index;
+		throw;
+	}
+	return { this, inserted == npos ? pos.index : inserted };
+}
+
+template <class T, class Allocator>
+template <typename InputIt, typename>
+void IndexLinkedList<T, Allocator>::append_range(InputIt first, InputIt last) {
+	insert_range(cend(), first, last);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::splice(const_iterator pos, IndexLinkedList &other) {
+	if (&other == this || other.empty()) return;
+	insert_range(pos, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+	other.clear();
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::splice(const_iterator pos, IndexLinkedList &&other) {
+	splice(pos, other);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::splice(const_iterator pos, IndexLinkedList &other, const_iterator it) {
+	if (&other != this) {
+		emplace(pos, std::move(other.values[it.index]));
+		other.erase(it);
+		return;
+	}
+	if (it.index == pos.index || next_links[it.index] == pos.index) return;
+	unlink_range(it.index, it.index);
+	link_range_before(pos.index, it.index, it.index);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::splice(const_iterator pos, IndexLinkedList &&other, const_iterator it) {
+	splice(pos, other, it);
+}
+
+// pos must not be inside [first, last) when both are the same list
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::splice(const_iterator pos, IndexLinkedList &other, const_iterator first, const_iterator last) {
+	if (first == last) return;
+	if (&other != this) {
+		insert_range(pos, std::make_move_iterator(iterator{ &other, first.index }), std::make_move_iterator(iterator{ &other, last.index }));
+		while (first != last) first = other.erase(first);
+		return;
+	}
+
+	if (pos.index == first.index || pos.index == last.index) return;
+	const index_type last_moved = last.index == npos ? tail : previous_links[last.index];
+	unlink_range(first.index, last_moved);
+	link_range_before(pos.index, first.index, last_moved);
+}
+
+template <class T, class Allocator>
+void IndexLinkedList<T, Allocator>::splice(const_iterator pos, IndexLinkedList &&other, const_iterator first, const_iterator last) {
+	splice(pos, other, first, last);
+}
+
+template <class T, class Allocator>
+std::ostream& operator<<(std::ostream &str, const IndexLinkedList<T, Allocator>& list) {
+	for (auto const& item : list) {
+		str << item << "\t";
+	}
+	return str;
+}
+
+#endif
@@ -0,0 +1,423 @@
+//
+//  IntrusiveDoubleLinkedList.h
+//  Data Structure - LinkedList
+//
+// A doubly linked list that links objects it does not own. The links live in
+// a DoubleLinkHook member of T, so inserting never allocates, copies or moves
+// the object; the caller keeps it alive for as long as it is linked.
+//
+//     struct Connection {
+//         int fd;
+//         DoubleLinkHook<Connection> hook;
+//     };
+//     IntrusiveDoubleLinkedList<Connection, &Connection::hook> idle;
+//     idle.erase(connection);      // O(1), straight from the object
+//
+// An object can sit in as many lists at once as it has hooks.
+//
+
+#ifndef INTRUSIVEDOUBLELINKEDLIST_h
+#define INTRUSIVEDOUBLELINKEDLIST_h
+
+
+template <class T>
+struct DoubleLinkHook {
+	T* next = nullptr;
+	T* previous = nullptr;
+
+	DoubleLinkHook() = default;
+	DoubleLinkHook(const DoubleLinkHook&) noexcept {}					// a copy of an object is not linked anywhere
+	DoubleLinkHook& operator=(const DoubleLinkHook&) noexcept { return *this; }
+};
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+class IntrusiveDoubleLinkedList {
+private:
+
+	T* head = nullptr;
+	T* tail = nullptr;
+	std::size_t length = 0;
+
+	static DoubleLinkHook<T>& hook(T& x) noexcept { return x.*Hook; }
+	static T* next_of(T* x) noexcept { return (x->*Hook).next; }
+	static T* previous_of(T* x) noexcept { return (x->*Hook).previous; }
+
+	std::size_t count_nodes() const;
+
+public:
+	// Constructors
+	using size_type = std::size_t;
+
+	IntrusiveDoubleLinkedList() = default;
+	IntrusiveDoubleLinkedList(IntrusiveDoubleLinkedList const &) = delete;		// an object has one hook per list
+	IntrusiveDoubleLinkedList& operator=(IntrusiveDoubleLinkedList const &) = delete;
+	IntrusiveDoubleLinkedList(IntrusiveDoubleLinkedList &&move) noexcept;
+	IntrusiveDoubleLinkedList& operator=(IntrusiveDoubleLinkedList &&move) noexcept;
+	~IntrusiveDoubleLinkedList() noexcept;
+
+	// Create an iterator class
+	class iterator;
+	iterator begin() noexcept;
+	iterator end() noexcept;
+	iterator iterator_to(T &x) noexcept;
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator cbegin() const noexcept;
+	const_iterator cend() const noexcept;
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept;
+
+	// Reverse iteator
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+	reverse_iterator rbegin() noexcept { return reverse_iterator{ end() }; }
+	const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{ end() }; }
+	const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator{ end() }; }
+
+	reverse_iterator rend() noexcept { return reverse_iterator{ begin() }; }
+	const_reverse_iterator rend() const noexcept { return const_reverse_iterator{ begin() }; }
+	const_reverse_iterator crend() const noexcept { return const_reverse_iterator{ begin() }; }
+
+	// Memeber functions
+	void swap(IntrusiveDoubleLinkedList &other) noexcept;
+	bool empty() const noexcept { return head == nullptr; }
+	size_type size() const noexcept;
+
+	T& front() { return *head; }
+	T& back() { return *tail; }
+
+	void push_front(T &x) noexcept;
+	void push_back(T &x) noexcept;
+	iterator insert(const_iterator pos, T &x) noexcept;
+	void pop_front() noexcept;
+	void pop_back() noexcept;
+	iterator erase(const_iterator pos) noexcept;
+	iterator erase(T &x) noexcept;
+	void clear() noexcept;
+};
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+class IntrusiveDoubleLinkedList<T, Hook>::iterator {
+	T* node = nullptr;
+	bool end_reached = true;
+
+public:
+	friend class IntrusiveDoubleLinkedList<T, Hook>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T * ;
+	using reference = T & ;
+
+	iterator(T* node = nullptr, bool end_reached = false) : node{ node }, end_reached{ end_reached } {}
+
+	operator const_iterator() const noexcept { return const_iterator{ node, end_reached }; }
+	bool operator!=(iterator other) const noexcept { return !(*this == other); }
+	bool operator==(iterator other) const noexcept;
+
+	T& operator*() const { return *node; }
+	T* operator->() const { return node; }
+
+	iterator& operator++();
+	iterator operator++(int);
+	iterator& operator--();
+	iterator operator--(int);
+};
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+class IntrusiveDoubleLinkedList<T, Hook>::const_iterator {
+	T* node = nullptr;
+	bool end_reached = true;
+
+public:
+	friend class IntrusiveDoubleLinkedList<T, Hook>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T *;
+	using reference = const T &;
+
+	const_iterator() = default;
+	const_iterator(T* node, bool end_reached = false) : node{ node }, end_reached{ end_reached } {}
+
+	bool operator!=(const_iterator other) const noexcept { return !(*this == other); }
+	bool operator==(const_iterator other) const noexcept;
+
+	const T& operator*() const { return *node; }
+	const T* operator->() const { return node; }
+
+	const_iterator& operator++();
+	const_iterator operator++(int);
+	const_iterator& operator--();
+	const_iterator operator--(int);
+};
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+IntrusiveDoubleLinkedList<T, Hook>::IntrusiveDoubleLinkedList(IntrusiveDoubleLinkedList &&move) noexcept {
+	move.swap(*this);
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+IntrusiveDoubleLinkedList<T, Hook>& IntrusiveDoubleLinkedList<T, Hook>::operator=(IntrusiveDoubleLinkedList &&move) noexcept {
+	IntrusiveDoubleLinkedList taken{ std::move(move) };
+	swap(taken);
+	return *this;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+IntrusiveDoubleLinkedList<T, Hook>::~IntrusiveDoubleLinkedList() noexcept {
+	clear();
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+void IntrusiveDoubleLinkedList<T, Hook>::swap(IntrusiveDoubleLinkedList &other) noexcept {
+	using std::swap;
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(length, other.length);
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::size_type IntrusiveDoubleLinkedList<T, Hook>::size() const noexcept {
+	assert(length == count_nodes() && "cached size is out of sync with the chain");
+	return length;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+std::size_t IntrusiveDoubleLinkedList<T, Hook>::count_nodes() const {
+	std::size_t nodes = 0;
+	for (T* current = head; current != nullptr; current = next_of(current)) {
+		nodes++;
+	}
+	return nodes;
+}
+
+// Unlinks every object and resets its hook, the objects themselves are left alone
+template <class T, DoubleLinkHook<T> T::*Hook>
+void IntrusiveDoubleLinkedList<T, Hook>::clear() noexcept {
+	while (head) {
+		T* next = next_of(head);
+		hook(*head).next = nullptr;
+		hook(*head).previous = nullptr;
+		head = next;
+	}
+	tail = nullptr;
+	length = 0;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+void IntrusiveDoubleLinkedList<T, Hook>::push_front(T &x) noexcept {
+	insert(begin(), x);
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+void IntrusiveDoubleLinkedList<T, Hook>::push_back(T &x) noexcept {
+	insert(end(), x);
+}
+
+// Links x in front of pos
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::insert(const_iterator pos, T &x) noexcept {
+	T* next = pos.end_reached ? nullptr : pos.node;
+	T* previous = next ? previous_of(next) : tail;
+
+	hook(x).next = next;
+	hook(x).previous = previous;
+	if (previous) hook(*previous).next = &x;
+	else head = &x;
+	if (next) hook(*next).previous = &x;
+	else tail = &x;
+	++length;
+
+	return { &x };
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+void IntrusiveDoubleLinkedList<T, Hook>::pop_front() noexcept {
+	if (head) erase(*head);
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+void IntrusiveDoubleLinkedList<T, Hook>::pop_back() noexcept {
+	if (tail) erase(*tail);
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::erase(const_iterator pos) noexcept {
+	if (pos.end_reached) {
+		pop_back();
+		return end();
+	}
+
+	if (!pos.node) {
+		return end();
+	}
+
+	return erase(*pos.node);
+}
+
+// O(1) from the object alone, x has to be linked into this list
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::erase(T &x) noexcept {
+	T* next = hook(x).next;
+	T* previous = hook(x).previous;
+
+	if (previous) hook(*previous).next = next;
+	else head = next;
+	if (next) hook(*next).previous = previous;
+	else tail = previous;
+	hook(x).next = nullptr;
+	hook(x).previous = nullptr;
+	--length;
+
+	return next ? iterator{ next } : end();
+}
+
+// Iterator Implementaion////////////////////////////////////////////////
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator& IntrusiveDoubleLinkedList<T, Hook>::iterator::operator++() {
+	if (!node) return *this;
+
+	if (next_of(node)) {
+		node = next_of(node);
+	}
+
+	else {
+		end_reached = true;			// keep last node, so we can go backwards if required
+	}
+
+	return *this;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator& IntrusiveDoubleLinkedList<T, Hook>::iterator::operator--() {
+	if (!node) return *this;
+
+	if (end_reached) {
+		end_reached = false;
+	}
+
+	else if (previous_of(node)) {
+		node = previous_of(node);
+	}
+
+	return *this;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::iterator::operator--(int) {
+	auto copy = *this;
+	--*this;
+	return copy;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+bool IntrusiveDoubleLinkedList<T, Hook>::iterator::operator==(iterator other) const noexcept {
+	if (end_reached) return other.end_reached;
+
+	if (other.end_reached) return false;
+
+	return node == other.node;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::begin() noexcept {
+	return { head, !head };
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::end() noexcept {
+	return { tail, true };
+}
+
+// x has to be linked into this list
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::iterator IntrusiveDoubleLinkedList<T, Hook>::iterator_to(T &x) noexcept {
+	return { &x };
+}
+
+// Const Iterator Implementaion////////////////////////////////////////////////
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator& IntrusiveDoubleLinkedList<T, Hook>::const_iterator::operator++() {
+	if (!node) return *this;
+
+	if (next_of(node)) {
+		node = next_of(node);
+	}
+
+	else {
+		end_reached = true;			// keep last node, so we can go backwards if required
+	}
+
+	return *this;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator IntrusiveDoubleLinkedList<T, Hook>::const_iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator& IntrusiveDoubleLinkedList<T, Hook>::const_iterator::operator--() {
+	if (!node) return *this;
+
+	if (end_reached) {
+		end_reached = false;
+	}
+
+	else if (previous_of(node)) {
+		node = previous_of(node);
+	}
+
+	return *this;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator IntrusiveDoubleLinkedList<T, Hook>::const_iterator::operator--(int) {
+	auto copy = *this;
+	--*this;
+	return copy;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+bool IntrusiveDoubleLinkedList<T, Hook>::const_iterator::operator==(const_iterator other) const noexcept {
+	if (end_reached) return other.end_reached;
+
+	if (other.end_reached) return false;
+
+	return node == other.node;
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator IntrusiveDoubleLinkedList<T, Hook>::begin() const noexcept {
+	return { head, !head };
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator IntrusiveDoubleLinkedList<T, Hook>::end() const noexcept {
+	return { tail, true };
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator IntrusiveDoubleLinkedList<T, Hook>::cbegin() const noexcept {
+	return begin();
+}
+
+template <class T, DoubleLinkHook<T> T::*Hook>
+typename IntrusiveDoubleLinkedList<T, Hook>::const_iterator IntrusiveDoubleLinkedList<T, Hook>::cend() const noexcept {
+	return end();
+}
+
+#endif
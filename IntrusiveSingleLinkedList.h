@@ -0,0 +1,360 @@
+//
+//  IntrusiveSingleLinkedList.h
+//  Data Structure - LinkedList
+//
+// A singly linked list that links objects it does not own. The link lives in
+// a SingleLinkHook member of T, so inserting never allocates, copies or moves
+// the object; the caller keeps it alive for as long as it is linked.
+//
+//     struct Session {
+//         int id;
+//         SingleLinkHook<Session> hook;
+//     };
+//     IntrusiveSingleLinkedList<Session, &Session::hook> sessions;
+//
+// An object can sit in as many lists at once as it has hooks. Without a back
+// link only erase_after is O(1); remove(x) has to find the predecessor first.
+// Use IntrusiveDoubleLinkedList when objects must unlink themselves in O(1).
+//
+
+#ifndef INTRUSIVESINGLELINKEDLIST_h
+#define INTRUSIVESINGLELINKEDLIST_h
+
+
+template <class T>
+struct SingleLinkHook {
+	T* next = nullptr;
+
+	SingleLinkHook() = default;
+	SingleLinkHook(const SingleLinkHook&) noexcept {}					// a copy of an object is not linked anywhere
+	SingleLinkHook& operator=(const SingleLinkHook&) noexcept { return *this; }
+};
+
+template <class T, SingleLinkHook<T> T::*Hook>
+class IntrusiveSingleLinkedList {
+private:
+
+	T* head = nullptr;
+	T* tail = nullptr;
+	std::size_t length = 0;
+
+	static SingleLinkHook<T>& hook(T& x) noexcept { return x.*Hook; }
+	static T* next_of(T* x) noexcept { return (x->*Hook).next; }
+
+	std::size_t count_nodes() const;
+
+public:
+	// Constructors
+	using size_type = std::size_t;
+
+	IntrusiveSingleLinkedList() = default;
+	IntrusiveSingleLinkedList(IntrusiveSingleLinkedList const &) = delete;		// an object has one hook per list
+	IntrusiveSingleLinkedList& operator=(IntrusiveSingleLinkedList const &) = delete;
+	IntrusiveSingleLinkedList(IntrusiveSingleLinkedList &&move) noexcept;
+	IntrusiveSingleLinkedList& operator=(IntrusiveSingleLinkedList &&move) noexcept;
+	~IntrusiveSingleLinkedList() noexcept;
+
+	// Create an iterator class
+	class iterator;
+	iterator begin() noexcept;
+	iterator end() noexcept;
+	iterator before_begin() noexcept;
+	iterator iterator_to(T &x) noexcept;
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator cbegin() const noexcept;
+	const_iterator cend() const noexcept;
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept;
+	const_iterator before_begin() const noexcept;
+	const_iterator cbefore_begin() const noexcept;
+
+	// Memeber functions
+	void swap(IntrusiveSingleLinkedList &other) noexcept;
+	bool empty() const noexcept { return head == nullptr; }
+	size_type size() const noexcept;
+
+	T& front() { return *head; }
+	T& back() { return *tail; }
+
+	void push_front(T &x) noexcept;
+	void push_back(T &x) noexcept;
+	iterator insert_after(const_iterator pos, T &x);
+	void pop_front() noexcept;
+	iterator erase_after(const_iterator pos) noexcept;
+	bool remove(T &x) noexcept;
+	void clear() noexcept;
+};
+
+template <class T, SingleLinkHook<T> T::*Hook>
+class IntrusiveSingleLinkedList<T, Hook>::iterator {
+	T* node = nullptr;
+	bool before_begin = false;
+
+public:
+	friend class IntrusiveSingleLinkedList<T, Hook>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T * ;
+	using reference = T & ;
+
+	iterator(T* node = nullptr, bool before = false) : node{ node }, before_begin{ before } {}
+
+	operator const_iterator() const noexcept { return const_iterator{ node, before_begin }; }
+	bool operator!=(iterator other) const noexcept { return !(*this == other); }
+	bool operator==(iterator other) const noexcept { return node == other.node && before_begin == other.before_begin; }
+
+	T& operator*() const { return *node; }
+	T* operator->() const { return node; }
+
+	iterator& operator++();
+	iterator operator++(int);
+};
+
+template <class T, SingleLinkHook<T> T::*Hook>
+class IntrusiveSingleLinkedList<T, Hook>::const_iterator {
+	T* node = nullptr;
+	bool before_begin = false;
+
+public:
+	friend class IntrusiveSingleLinkedList<T, Hook>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T * ;
+	using reference = const T & ;
+
+	const_iterator() = default;
+	const_iterator(T* node, bool before = false) : node{ node }, before_begin{ before } {}
+
+	bool operator!=(const_iterator other) const noexcept { return !(*this == other); }
+	bool operator==(const_iterator other) const noexcept { return node == other.node && before_begin == other.before_begin; }
+
+	const T& operator*() const { return *node; }
+	const T* operator->() const { return node; }
+
+	const_iterator& operator++();
+	const_iterator operator++(int);
+};
+
+template <class T, SingleLinkHook<T> T::*Hook>
+IntrusiveSingleLinkedList<T, Hook>::IntrusiveSingleLinkedList(IntrusiveSingleLinkedList &&move) noexcept {
+	move.swap(*this);
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+IntrusiveSingleLinkedList<T, Hook>& IntrusiveSingleLinkedList<T, Hook>::operator=(IntrusiveSingleLinkedList &&move) noexcept {
+	IntrusiveSingleLinkedList taken{ std::move(move) };
+	swap(taken);
+	return *this;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+IntrusiveSingleLinkedList<T, Hook>::~IntrusiveSingleLinkedList() noexcept {
+	clear();
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+void IntrusiveSingleLinkedList<T, Hook>::swap(IntrusiveSingleLinkedList &other) noexcept {
+	using std::swap;
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(length, other.length);
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::size_type IntrusiveSingleLinkedList<T, Hook>::size() const noexcept {
+	assert(length == count_nodes() && "cached size is out of sync with the chain");
+	return length;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+std::size_t IntrusiveSingleLinkedList<T, Hook>::count_nodes() const {
+	std::size_t nodes = 0;
+	for (T* current = head; current != nullptr; current = next_of(current)) {
+		nodes++;
+	}
+	return nodes;
+}
+
+// Unlinks every object and resets its hook, the objects themselves are left alone
+template <class T, SingleLinkHook<T> T::*Hook>
+void IntrusiveSingleLinkedList<T, Hook>::clear() noexcept {
+	while (head) {
+		T* next = next_of(head);
+		hook(*head).next = nullptr;
+		head = next;
+	}
+	tail = nullptr;
+	length = 0;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+void IntrusiveSingleLinkedList<T, Hook>::push_front(T &x) noexcept {
+	hook(x).next = head;
+	head = &x;
+	if (!tail) tail = head;
+	++length;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+void IntrusiveSingleLinkedList<T, Hook>::push_back(T &x) noexcept {
+	hook(x).next = nullptr;
+	if (tail) hook(*tail).next = &x;
+	else head = &x;
+	tail = &x;
+	++length;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator IntrusiveSingleLinkedList<T, Hook>::insert_after(const_iterator pos, T &x) {
+	if (pos.before_begin) {
+		push_front(x);
+		return begin();
+	}
+
+	if (pos.node) {
+		hook(x).next = next_of(pos.node);
+		hook(*pos.node).next = &x;
+		if (pos.node == tail) tail = &x;
+		++length;
+		return { &x };
+	}
+	throw std::out_of_range{ "end iterator got passed to insert!" };
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+void IntrusiveSingleLinkedList<T, Hook>::pop_front() noexcept {
+	if (!head) return;
+
+	T* first = head;
+	head = next_of(first);
+	hook(*first).next = nullptr;
+	if (!head) tail = nullptr;
+	--length;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator IntrusiveSingleLinkedList<T, Hook>::erase_after(const_iterator pos) noexcept {
+	if (pos.before_begin) {
+		pop_front();
+		return begin();
+	}
+
+	if (pos.node && next_of(pos.node)) {
+		T* victim = next_of(pos.node);
+		hook(*pos.node).next = next_of(victim);
+		hook(*victim).next = nullptr;
+		if (victim == tail) tail = pos.node;
+		--length;
+		return { next_of(pos.node) };
+	}
+
+	return end();
+}
+
+// O(n), the predecessor of x has to be found first
+template <class T, SingleLinkHook<T> T::*Hook>
+bool IntrusiveSingleLinkedList<T, Hook>::remove(T &x) noexcept {
+	if (head == &x) {
+		pop_front();
+		return true;
+	}
+
+	for (T* current = head; current != nullptr; current = next_of(current)) {
+		if (next_of(current) == &x) {
+			erase_after(const_iterator{ current });
+			return true;
+		}
+	}
+	return false;
+}
+
+// Iterator Implementaion////////////////////////////////////////////////
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator& IntrusiveSingleLinkedList<T, Hook>::iterator::operator++() {
+	if (before_begin) before_begin = false;
+	else node = next_of(node);
+
+	return *this;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator IntrusiveSingleLinkedList<T, Hook>::iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator IntrusiveSingleLinkedList<T, Hook>::begin() noexcept {
+	return head;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator IntrusiveSingleLinkedList<T, Hook>::end() noexcept {
+	return {};
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator IntrusiveSingleLinkedList<T, Hook>::before_begin() noexcept {
+	return { head, true };
+}
+
+// x has to be linked into this list
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::iterator IntrusiveSingleLinkedList<T, Hook>::iterator_to(T &x) noexcept {
+	return { &x };
+}
+
+// Const Iterator Implementaion////////////////////////////////////////////////
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator& IntrusiveSingleLinkedList<T, Hook>::const_iterator::operator++() {
+	if (before_begin) before_begin = false;
+	else node = next_of(node);
+
+	return *this;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator IntrusiveSingleLinkedList<T, Hook>::const_iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator IntrusiveSingleLinkedList<T, Hook>::begin() const noexcept {
+	return head;
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator IntrusiveSingleLinkedList<T, Hook>::end() const noexcept {
+	return {};
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator IntrusiveSingleLinkedList<T, Hook>::cbegin() const noexcept {
+	return begin();
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator IntrusiveSingleLinkedList<T, Hook>::cend() const noexcept {
+	return end();
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator IntrusiveSingleLinkedList<T, Hook>::before_begin() const noexcept {
+	return { head, true };
+}
+
+template <class T, SingleLinkHook<T> T::*Hook>
+typename IntrusiveSingleLinkedList<T, Hook>::const_iterator IntrusiveSingleLinkedList<T, Hook>::cbefore_begin() const noexcept {
+	return before_begin();
+}
+
+#endif
@@ -0,0 +1,147 @@
+//
+//  KeySet.h
+//  Data Structure - LinkedList
+//
+// The lookup side of the lists' search_many(). Keys and elements are matched
+// with operator==, like the lists' search(), and one pass over a list checks
+// all of the keys instead of k passes.
+//
+// Keys with an operator< are sorted once and every element is probed with a
+// binary search, O(n log k). An operator< may order by less than == compares
+// (a struct sorted on one member), so a probe checks the whole run of keys
+// it finds equivalent with ==. NaN keys are dropped before sorting, they break
+// the ordering and == never matches them anyway. Keys without an operator<
+// go into a hash table when std::hash supports them, and only keys with
+// neither are compared against each element one by one.
+//
+
+#ifndef KEYSET_h
+#define KEYSET_h
+
+
+namespace detail {
+
+	template <class T, class = void>
+	struct has_less : std::false_type {};
+
+	template <class T>
+	struct has_less<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>> : std::true_type {};
+
+	template <class T, class = void>
+	struct has_hash : std::false_type {};
+
+	template <class T>
+	struct has_hash<T, std::void_t<decltype(std::hash<T>()(std::declval<const T&>()))>> : std::is_default_constructible<std::hash<T>> {};
+
+	template <class T>
+	class KeySet {
+		enum class Lookup { Sorted, Hashed, Linear };
+		static constexpr Lookup lookup = has_less<T>::value ? Lookup::Sorted : has_hash<T>::value ? Lookup::Hashed : Lookup::Linear;
+		static constexpr std::size_t never = ~std::size_t(0);		// slot of a key that can't match, a NaN
+
+		std::vector<T> distinct;						// the keys, duplicates dropped, sorted for Lookup::Sorted
+		// Key to entry of seen, only built for Lookup::Hashed
+		using hash_table = std::conditional_t<lookup == Lookup::Hashed, std::unordered_map<T, std::size_t>, std::tuple<>>;
+		hash_table slots;
+		std::vector<std::size_t> slot_of;				// where each key as given ended up
+		std::vector<bool> seen;							// per distinct key
+		std::size_t unseen = 0;
+
+		void see(std::size_t slot) noexcept {
+			if (!seen[slot]) {
+				seen[slot] = true;
+				--unseen;
+			}
+		}
+
+	public:
+		template <typename InputIt>
+		KeySet(InputIt first, InputIt last);
+
+		// Every key has been seen, a walk can stop
+		bool done() const noexcept { return unseen == 0; }
+
+		// Notes value if it is one of the keys, returns done()
+		bool mark(const T &value);
+
+		// Per key in the order they were given, whether mark() saw it
+		std::vector<bool> found() const;
+	};
+
+	template <class T>
+	template <typename InputIt>
+	KeySet<T>::KeySet(InputIt first, InputIt last) {
+		std::vector<T> keys(first, last);
+		slot_of.assign(keys.size(), never);
+		std::size_t count = 0;
+
+		if constexpr (lookup == Lookup::Sorted) {
+			std::vector<std::size_t> order;
+			order.reserve(keys.size());
+			for (std::size_t index = 0; index < keys.size(); ++index) {
+				if constexpr (std::is_floating_point<T>::value) {
+					if (keys[index] != keys[index]) continue;
+				}
+				order.push_back(index);
+			}
+			std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return std::less<T>()(keys[a], keys[b]); });
+
+			// Duplicates can only sit in the run of keys equivalent to the current one
+			distinct.reserve(order.size());
+			std::size_t run = 0;
+			for (std::size_t index : order) {
+				if (distinct.empty() || std::less<T>()(distinct.back(), keys[index])) run = distinct.size();
+				const auto it = std::find(distinct.begin() + std::ptrdiff_t(run), distinct.end(), keys[index]);
+				slot_of[index] = static_cast<std::size_t>(it - distinct.begin());
+				if (it == distinct.end()) distinct.push_back(std::move(keys[index]));
+			}
+			count = distinct.size();
+		}
+		else if constexpr (lookup == Lookup::Hashed) {
+			slots.reserve(keys.size());
+			for (std::size_t index = 0; index < keys.size(); ++index) {
+				slot_of[index] = slots.emplace(std::move(keys[index]), slots.size()).first->second;
+			}
+			count = slots.size();
+		}
+		else {
+			for (std::size_t index = 0; index < keys.size(); ++index) {
+				const auto it = std::find(distinct.begin(), distinct.end(), keys[index]);
+				slot_of[index] = static_cast<std::size_t>(it - distinct.begin());
+				if (it == distinct.end()) distinct.push_back(std::move(keys[index]));
+			}
+			count = distinct.size();
+		}
+		seen.assign(count, false);
+		unseen = count;
+	}
+
+	template <class T>
+	bool KeySet<T>::mark(const T &value) {
+		if constexpr (lookup == Lookup::Sorted) {
+			auto it = std::lower_bound(distinct.begin(), distinct.end(), value, std::less<T>());
+			for (; it != distinct.end() && !std::less<T>()(value, *it); ++it) {
+				if (value == *it) see(static_cast<std::size_t>(it - distinct.begin()));
+			}
+		}
+		else if constexpr (lookup == Lookup::Hashed) {
+			const auto it = slots.find(value);
+			if (it != slots.end()) see(it->second);
+		}
+		else {
+			for (std::size_t slot = 0; slot < distinct.size(); ++slot) {
+				if (!seen[slot] && value == distinct[slot]) see(slot);
+			}
+		}
+		return done();
+	}
+
+	template <class T>
+	std::vector<bool> KeySet<T>::found() const {
+		std::vector<bool> result(slot_of.size());
+		for (std::size_t index = 0; index < slot_of.size(); ++index) result[index] = slot_of[index] != never && seen[slot_of[index]];
+		return result;
+	}
+}
+
+#endif
@@ -0,0 +1,567 @@
+//
+//  LinkedHashMap.h
+//  Data Structure - LinkedList
+//
+// A hash map whose entries also form a doubly linked list. Every node holds
+// its key/value pair together with the link to the next node in its hash
+// bucket and the previous/next links of the list, so an entry costs one
+// allocation and an iterator stays valid until its own entry is erased.
+//
+// New entries go to the front of the list. With LinkOrder::Access, looking an
+// entry up through find(), at() or operator[] moves it to the front as well,
+// so the back is always the least recently used entry. Iteration runs from
+// front to back.
+//
+// With a capacity set, inserting into a full map first evicts the entry at
+// the back and hands it to the eviction callback, which makes an LRU cache:
+//
+//     LinkedHashMap<int, Page, std::hash<int>, std::equal_to<int>, LinkOrder::Access> cache;
+//     cache.set_capacity(1024);
+//     cache.set_eviction_callback([](std::pair<const int, Page>& entry) { write_back(entry); });
+//
+
+#ifndef LINKEDHASHMAP_h
+#define LINKEDHASHMAP_h
+
+
+enum class LinkOrder {
+	Insertion,
+	Access
+};
+
+template <class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+	LinkOrder Order = LinkOrder::Insertion, class Allocator = std::allocator<std::pair<const Key, Value>>>
+class LinkedHashMap {
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using value_type = std::pair<const Key, Value>;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+private:
+
+	struct Node {
+		value_type entry;
+		std::size_t hash;
+		Node* bucket_next = nullptr;
+		Node* previous = nullptr;
+		Node* next = nullptr;
+
+		template<typename... Args>
+		explicit Node(std::size_t hash, Args&&... args) : entry(std::forward<Args>(args)...), hash{ hash } {}
+	};
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+	using bucket_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node*>;
+
+	std::vector<Node*, bucket_allocator> buckets;
+	unsigned bucket_bits = 0;			// buckets.size() == 1 << bucket_bits once allocated
+	Node* head = nullptr;
+	Node* tail = nullptr;
+	std::size_t length = 0;
+	std::size_t capacity = 0;			// 0 means unbounded
+	std::function<void(value_type&)> on_evict;
+	Hash hash_function;
+	KeyEqual equal;
+	node_allocator alloc;
+
+	// Fibonacci hashing spreads out hashes that only differ in their high bits
+	std::size_t bucket_index(std::size_t hash) const noexcept {
+		return bucket_bits == 0 ? 0 : std::size_t((std::uint64_t(hash) * 0x9E3779B97F4A7C15ull) >> (64 - bucket_bits));
+	}
+
+	Node* find_node(const Key &key, std::size_t hash) const;
+
+	template <typename... Args>
+	Node* make_node(std::size_t hash, Args&&... args);
+	void free_node(Node* node) noexcept;
+
+	void link_front(Node* node) noexcept;
+	void unlink(Node* node) noexcept;
+	void touch(Node* node) noexcept {
+		if constexpr (Order == LinkOrder::Access) move_node_to_front(node);
+	}
+	void move_node_to_front(Node* node) noexcept;
+
+	void insert_node(Node* node);
+	void erase_node(Node* node) noexcept;
+	void rehash_to(unsigned bits);
+	void evict_if_full();
+
+public:
+	// Constructors
+	LinkedHashMap() = default;
+	explicit LinkedHashMap(size_type bucket_count, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(), const Allocator &alloc = Allocator());
+	LinkedHashMap(std::initializer_list<value_type> init);
+	LinkedHashMap(LinkedHashMap const &source);
+	LinkedHashMap(LinkedHashMap &&move) noexcept;
+	LinkedHashMap& operator=(LinkedHashMap const &rhs);
+	LinkedHashMap& operator=(LinkedHashMap &&move) noexcept;
+	~LinkedHashMap() noexcept;
+
+	// Create an iterator class
+	class iterator;
+	iterator begin() noexcept { return { head, this }; }
+	iterator end() noexcept { return { nullptr, this }; }
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator begin() const noexcept { return { head, this }; }
+	const_iterator end() const noexcept { return { nullptr, this }; }
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+
+	// Memeber functions
+	void swap(LinkedHashMap &other) noexcept;
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+	bool empty() const noexcept { return length == 0; }
+	size_type size() const noexcept { return length; }
+	size_type bucket_count() const noexcept { return buckets.size(); }
+	float load_factor() const noexcept { return buckets.empty() ? 0.0f : float(length) / float(buckets.size()); }
+	void reserve(size_type count);
+
+	// The oldest entry is evicted once an insertion would go over capacity, 0 turns that off
+	void set_capacity(size_type max_entries);
+	size_type get_capacity() const noexcept { return capacity; }
+	void set_eviction_callback(std::function<void(value_type&)> callback) { on_evict = std::move(callback); }
+
+	template<typename... Args>
+	std::pair<iterator, bool> emplace(Args&&... args);
+
+	template<typename... Args>
+	std::pair<iterator, bool> try_emplace(const Key &key, Args&&... args);
+
+	std::pair<iterator, bool> insert(const value_type &theData);
+	std::pair<iterator, bool> insert(value_type &&theData);
+
+	template<typename M>
+	std::pair<iterator, bool> insert_or_assign(const Key &key, M&& value);
+
+	// Lookups that count as an access
+	iterator find(const Key &key);
+	Value& at(const Key &key);
+	Value& operator[](const Key &key);
+
+	// Lookups that leave the order alone
+	const_iterator peek(const Key &key) const;
+	bool contains(const Key &key) const { return find_node(key, hash_function(key)) != nullptr; }
+	size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+	size_type erase(const Key &key);
+	iterator erase(const_iterator pos);
+	void move_to_front(const_iterator pos) noexcept;
+	void move_to_back(const_iterator pos) noexcept;
+
+	value_type& front() { return head->entry; }
+	value_type& back() { return tail->entry; }
+	void pop_front();
+	void pop_back();
+	void clear() noexcept;
+};
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+class LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator {
+	Node* node = nullptr;
+	const LinkedHashMap* owner = nullptr;
+
+public:
+	friend class LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = typename LinkedHashMap::value_type;
+	using difference_type = std::ptrdiff_t;
+	using pointer = value_type * ;
+	using reference = value_type & ;
+
+	iterator() = default;
+	iterator(Node* node, const LinkedHashMap* owner) : node{ node }, owner{ owner } {}
+
+	operator const_iterator() const noexcept { return const_iterator{ node, owner }; }
+	bool operator!=(iterator other) const noexcept { return node != other.node; }
+	bool operator==(iterator other) const noexcept { return node == other.node; }
+
+	value_type& operator*() const { return node->entry; }
+	value_type* operator->() const { return &node->entry; }
+
+	iterator& operator++() { node = node->next; return *this; }
+	iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+	iterator& operator--() { node = node ? node->previous : owner->tail; return *this; }
+	iterator operator--(int) { auto copy = *this; --*this; return copy; }
+};
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+class LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::const_iterator {
+	Node* node = nullptr;
+	const LinkedHashMap* owner = nullptr;
+
+public:
+	friend class LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>;
+
+	using iterator_category = std::bidirectional_iterator_tag;
+	using value_type = typename LinkedHashMap::value_type;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const value_type * ;
+	using reference = const value_type & ;
+
+	const_iterator() = default;
+	const_iterator(Node* node, const LinkedHashMap* owner) : node{ node }, owner{ owner } {}
+
+	bool operator!=(const_iterator other) const noexcept { return node != other.node; }
+	bool operator==(const_iterator other) const noexcept { return node == other.node; }
+
+	const value_type& operator*() const { return node->entry; }
+	const value_type* operator->() const { return &node->entry; }
+
+	const_iterator& operator++() { node = node->next; return *this; }
+	const_iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+	const_iterator& operator--() { node = node ? node->previous : owner->tail; return *this; }
+	const_iterator operator--(int) { auto copy = *this; --*this; return copy; }
+};
+
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::LinkedHashMap(size_type bucket_count, const Hash &hash, const KeyEqual &equal, const Allocator &alloc)
+	: buckets(bucket_allocator{ alloc }), hash_function{ hash }, equal{ equal }, alloc{ alloc } {
+	reserve(bucket_count);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::LinkedHashMap(std::initializer_list<value_type> init) {
+	reserve(init.size());
+	for (const value_type& entry : init) insert(entry);
+}
+
+// Copies the entries back to front, so the copy comes out in the same order
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::LinkedHashMap(LinkedHashMap const &source)
+	: buckets(bucket_allocator{ node_traits::select_on_container_copy_construction(source.alloc) })
+	, capacity{ source.capacity }, on_evict{ source.on_evict }, hash_function{ source.hash_function }, equal{ source.equal }
+	, alloc{ node_traits::select_on_container_copy_construction(source.alloc) } {
+	reserve(source.length);
+	try {
+		for (const Node* node = source.tail; node != nullptr; node = node->previous) {
+			insert_node(make_node(node->hash, node->entry));
+		}
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::LinkedHashMap(LinkedHashMap &&move) noexcept {
+	move.swap(*this);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>& LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::operator=(LinkedHashMap const &rhs) {
+	LinkedHashMap copy{ rhs };
+	swap(copy);
+	return *this;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>& LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::operator=(LinkedHashMap &&move) noexcept {
+	move.swap(*this);
+	return *this;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::~LinkedHashMap() noexcept {
+	clear();
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::swap(LinkedHashMap &other) noexcept {
+	using std::swap;
+	swap(buckets, other.buckets);
+	swap(bucket_bits, other.bucket_bits);
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(length, other.length);
+	swap(capacity, other.capacity);
+	swap(on_evict, other.on_evict);
+	swap(hash_function, other.hash_function);
+	swap(equal, other.equal);
+	swap(alloc, other.alloc);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::Node* LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::find_node(const Key &key, std::size_t hash) const {
+	if (buckets.empty()) return nullptr;
+	for (Node* node = buckets[bucket_index(hash)]; node != nullptr; node = node->bucket_next) {
+		if (node->hash == hash && equal(node->entry.first, key)) return node;
+	}
+	return nullptr;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+template <typename... Args>
+typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::Node* LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::make_node(std::size_t hash, Args&&... args) {
+	Node* node = node_traits::allocate(alloc, 1);
+	try {
+		node_traits::construct(alloc, node, hash, std::forward<Args>(args)...);
+	}
+	catch (...) {
+		node_traits::deallocate(alloc, node, 1);
+		throw;
+	}
+	return node;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::free_node(Node* node) noexcept {
+	node_traits::destroy(alloc, node);
+	node_traits::deallocate(alloc, node, 1);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::link_front(Node* node) noexcept {
+	node->previous = nullptr;
+	node->next = head;
+	if (head) head->previous = node;
+	else tail = node;
+	head = node;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::unlink(Node* node) noexcept {
+	if (node->previous) node->previous->next = node->next;
+	else head = node->next;
+	if (node->next) node->next->previous = node->previous;
+	else tail = node->previous;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::move_node_to_front(Node* node) noexcept {
+	if (node == head) return;
+	unlink(node);
+	link_front(node);
+}
+
+// Links a node whose key is not in the map yet into its bucket and the front of the list
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::insert_node(Node* node) {
+	if (length + 1 > buckets.size()) {
+		try {
+			rehash_to(buckets.empty() ? 4 : bucket_bits + 1);
+		}
+		catch (...) {
+			if (buckets.empty()) {
+				free_node(node);
+				throw;
+			}
+			// A full table still works, just with longer chains
+		}
+	}
+
+	Node*& bucket = buckets[bucket_index(node->hash)];
+	node->bucket_next = bucket;
+	bucket = node;
+	link_front(node);
+	++length;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::erase_node(Node* node) noexcept {
+	Node** link = &buckets[bucket_index(node->hash)];
+	while (*link != node) link = &(*link)->bucket_next;
+	*link = node->bucket_next;
+
+	unlink(node);
+	free_node(node);
+	--length;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::rehash_to(unsigned bits) {
+	std::vector<Node*, bucket_allocator> grown(std::size_t(1) << bits, nullptr, buckets.get_allocator());
+	buckets.swap(grown);
+	bucket_bits = bits;
+
+	for (Node* node = head; node != nullptr; node = node->next) {
+		Node*& bucket = buckets[bucket_index(node->hash)];
+		node->bucket_next = bucket;
+		bucket = node;
+	}
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::evict_if_full() {
+	if (capacity == 0 || length < capacity) return;
+
+	Node* oldest = tail;
+	if (on_evict) on_evict(oldest->entry);
+	erase_node(oldest);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::reserve(size_type count) {
+	unsigned bits = buckets.empty() ? 2 : bucket_bits;
+	while ((std::size_t(1) << bits) < count) ++bits;
+	if (buckets.empty() || bits > bucket_bits) rehash_to(bits);
+}
+
+// Shrinking evicts from the back, through the callback, until the map fits
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::set_capacity(size_type max_entries) {
+	capacity = max_entries;
+	while (capacity != 0 && length > capacity) {
+		Node* oldest = tail;
+		if (on_evict) on_evict(oldest->entry);
+		erase_node(oldest);
+	}
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+template <typename... Args>
+std::pair<typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator, bool> LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::emplace(Args&&... args) {
+	// The key is only known once the pair is built
+	Node* node = make_node(0, std::forward<Args>(args)...);
+	try {
+		node->hash = hash_function(node->entry.first);
+		if (Node* existing = find_node(node->entry.first, node->hash)) {
+			free_node(node);
+			touch(existing);
+			return { { existing, this }, false };
+		}
+		evict_if_full();
+	}
+	catch (...) {
+		free_node(node);
+		throw;
+	}
+	insert_node(node);
+	return { { node, this }, true };
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+template <typename... Args>
+std::pair<typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator, bool> LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::try_emplace(const Key &key, Args&&... args) {
+	const std::size_t hash = hash_function(key);
+	if (Node* existing = find_node(key, hash)) {
+		touch(existing);
+		return { { existing, this }, false };
+	}
+
+	Node* node = make_node(hash, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+	try {
+		evict_if_full();
+	}
+	catch (...) {
+		free_node(node);
+		throw;
+	}
+	insert_node(node);
+	return { { node, this }, true };
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+std::pair<typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator, bool> LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::insert(const value_type &theData) {
+	return try_emplace(theData.first, theData.second);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+std::pair<typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator, bool> LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::insert(value_type &&theData) {
+	return try_emplace(theData.first, std::move(theData.second));
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+template <typename M>
+std::pair<typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator, bool> LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::insert_or_assign(const Key &key, M&& value) {
+	auto inserted = try_emplace(key, std::forward<M>(value));
+	if (!inserted.second) inserted.first->second = std::forward<M>(value);
+	return inserted;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::find(const Key &key) {
+	Node* node = find_node(key, hash_function(key));
+	if (node) touch(node);
+	return { node, this };
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+Value& LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::at(const Key &key) {
+	Node* node = find_node(key, hash_function(key));
+	if (!node) throw std::out_of_range("Key is not in the map");
+	touch(node);
+	return node->entry.second;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+Value& LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::operator[](const Key &key) {
+	return try_emplace(key).first->second;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::const_iterator LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::peek(const Key &key) const {
+	return { find_node(key, hash_function(key)), this };
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::size_type LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::erase(const Key &key) {
+	Node* node = find_node(key, hash_function(key));
+	if (!node) return 0;
+	erase_node(node);
+	return 1;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+typename LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::iterator LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::erase(const_iterator pos) {
+	Node* next = pos.node->next;
+	erase_node(pos.node);
+	return { next, this };
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::move_to_front(const_iterator pos) noexcept {
+	move_node_to_front(pos.node);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::move_to_back(const_iterator pos) noexcept {
+	Node* node = pos.node;
+	if (node == tail) return;
+	unlink(node);
+	node->next = nullptr;
+	node->previous = tail;
+	tail->next = node;
+	tail = node;
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::pop_front() {
+	if (empty()) {
+		return;
+	}
+	erase_node(head);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::pop_back() {
+	if (empty()) {
+		return;
+	}
+	erase_node(tail);
+}
+
+template <class Key, class Value, class Hash, class KeyEqual, LinkOrder Order, class Allocator>
+void LinkedHashMap<Key, Value, Hash, KeyEqual, Order, Allocator>::clear() noexcept {
+	Node* current = head;
+	while (current) {
+		Node* next = current->next;
+		free_node(current);
+		current = next;
+	}
+	std::fill(buckets.begin(), buckets.end(), nullptr);
+	head = nullptr;
+	tail = nullptr;
+	length = 0;
+}
+
+#endif
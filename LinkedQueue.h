@@ -0,0 +1,232 @@
+//
+//  LinkedQueue.h
+//  Data Structure - LinkedList
+//
+// A linked FIFO queue for handing work from producer threads to a single
+// consumer thread, without a mutex.
+//
+// The list always starts with a dummy node. The consumer owns the front and
+// pops by stepping onto the next node, which becomes the new dummy. Producers
+// own the back. With one producer a push is two plain stores. With several,
+// each producer swaps itself in as the new back with one atomic exchange and
+// then links the old back to it, after Dmitry Vyukov's MPSC queue. Until that
+// link is stored the consumer sees the queue as ending before the new nodes.
+//
+// push_range() links a whole batch with a single exchange. pop_bulk() takes
+// every node that is linked in so far in one pass.
+//
+// Nodes come from PoolAllocator by default. Its per-thread free lists make
+// allocation on the producers and freeing on the consumer cheap, and the
+// consumer's long runs of frees go back to the shared pool for reuse.
+//
+
+#ifndef LINKEDQUEUE_h
+#define LINKEDQUEUE_h
+
+#include "PoolAllocator.h"
+
+
+enum class QueueMode {
+	SingleProducer,
+	MultiProducer
+};
+
+template <class T, QueueMode Mode = QueueMode::MultiProducer, class Allocator = PoolAllocator<T>>
+class LinkedQueue {
+private:
+
+	struct Node {
+		std::atomic<Node*> next{ nullptr };
+		union {
+			T data;			// not constructed in the dummy
+		};
+
+		Node() noexcept {}
+		~Node() {}
+	};
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+	using back_link = std::conditional_t<Mode == QueueMode::MultiProducer, std::atomic<Node*>, Node*>;
+
+	// The consumer's and the producers' ends sit on separate cache lines
+	alignas(64) Node* head = nullptr;
+	alignas(64) back_link tail{ nullptr };
+	alignas(64) node_allocator alloc;
+
+	Node* allocate_node();
+	void free_node(Node* node) noexcept;
+
+	template <typename... Args>
+	Node* make_node(Args&&... args);
+
+	void link_chain(Node* first, Node* last) noexcept;
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	// Constructors
+	explicit LinkedQueue(const Allocator &alloc = Allocator());
+	LinkedQueue(LinkedQueue const &) = delete;
+	LinkedQueue& operator=(LinkedQueue const &) = delete;
+	~LinkedQueue() noexcept;
+
+	// Producer side, any thread in MultiProducer mode, one thread otherwise
+	template<typename... Args>
+	void emplace(Args&&... args);
+
+	void push(const T &theData);
+	void push(T &&theData);
+
+	template<typename InputIt>
+	void push_range(InputIt first, InputIt last);
+
+	// Consumer side, one thread only
+	bool try_pop(T &out);
+
+	template<typename OutputIt>
+	size_type pop_bulk(OutputIt out, size_type max_count = size_type(-1));
+
+	bool empty() const noexcept { return head->next.load(std::memory_order_acquire) == nullptr; }
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+};
+
+template <class T, QueueMode Mode, class Allocator>
+LinkedQueue<T, Mode, Allocator>::LinkedQueue(const Allocator &alloc) : alloc{ alloc } {
+	head = allocate_node();
+	if constexpr (Mode == QueueMode::MultiProducer) tail.store(head, std::memory_order_relaxed);
+	else tail = head;
+}
+
+// Not safe while other threads use the queue
+template <class T, QueueMode Mode, class Allocator>
+LinkedQueue<T, Mode, Allocator>::~LinkedQueue() noexcept {
+	Node* dummy = head;
+	for (Node* node = dummy->next.load(std::memory_order_acquire); node != nullptr; ) {
+		Node* next = node->next.load(std::memory_order_acquire);
+		node->data.~T();
+		free_node(node);
+		node = next;
+	}
+	free_node(dummy);
+}
+
+template <class T, QueueMode Mode, class Allocator>
+typename LinkedQueue<T, Mode, Allocator>::Node* LinkedQueue<T, Mode, Allocator>::allocate_node() {
+	Node* node = node_traits::allocate(alloc, 1);
+	node_traits::construct(alloc, node);
+	return node;
+}
+
+template <class T, QueueMode Mode, class Allocator>
+void LinkedQueue<T, Mode, Allocator>::free_node(Node* node) noexcept {
+	node_traits::destroy(alloc, node);
+	node_traits::deallocate(alloc, node, 1);
+}
+
+template <class T, QueueMode Mode, class Allocator>
+template <typename... Args>
+typename LinkedQueue<T, Mode, Allocator>::Node* LinkedQueue<T, Mode, Allocator>::make_node(Args&&... args) {
+	Node* node = allocate_node();
+	try {
+		::new (static_cast<void*>(std::addressof(node->data))) T(std::forward<Args>(args)...);
+	}
+	catch (...) {
+		free_node(node);
+		throw;
+	}
+	return node;
+}
+
+// Makes first..last, already linked among themselves, the new back of the queue
+template <class T, QueueMode Mode, class Allocator>
+void LinkedQueue<T, Mode, Allocator>::link_chain(Node* first, Node* last) noexcept {
+	Node* previous;
+	if constexpr (Mode == QueueMode::MultiProducer) {
+		previous = tail.exchange(last, std::memory_order_acq_rel);
+	}
+	else {
+		previous = tail;
+		tail = last;
+	}
+	previous->next.store(first, std::memory_order_release);
+}
+
+template <class T, QueueMode Mode, class Allocator>
+template <typename... Args>
+void LinkedQueue<T, Mode, Allocator>::emplace(Args&&... args) {
+	Node* node = make_node(std::forward<Args>(args)...);
+	link_chain(node, node);
+}
+
+template <class T, QueueMode Mode, class Allocator>
+void LinkedQueue<T, Mode, Allocator>::push(const T &theData) {
+	emplace(theData);
+}
+
+template <class T, QueueMode Mode, class Allocator>
+void LinkedQueue<T, Mode, Allocator>::push(T &&theData) {
+	emplace(std::move(theData));
+}
+
+// The batch becomes visible to the consumer all at once, and in order
+template <class T, QueueMode Mode, class Allocator>
+template <typename InputIt>
+void LinkedQueue<T, Mode, Allocator>::push_range(InputIt first, InputIt last) {
+	Node* chain = nullptr;
+	Node* chain_tail = nullptr;
+	try {
+		for (; first != last; ++first) {
+			Node* node = make_node(*first);
+			if (chain_tail) chain_tail->next.store(node, std::memory_order_relaxed);
+			else chain = node;
+			chain_tail = node;
+		}
+	}
+	catch (...) {
+		while (chain) {
+			Node* next = chain->next.load(std::memory_order_relaxed);
+			chain->data.~T();
+			free_node(chain);
+			chain = next;
+		}
+		throw;
+	}
+	if (chain) link_chain(chain, chain_tail);
+}
+
+template <class T, QueueMode Mode, class Allocator>
+bool LinkedQueue<T, Mode, Allocator>::try_pop(T &out) {
+	Node* dummy = head;
+	Node* next = dummy->next.load(std::memory_order_acquire);
+	if (!next) return false;
+
+	out = std::move(next->data);	// the queue is unchanged if this throws
+	next->data.~T();
+	head = next;
+	free_node(dummy);
+	return true;
+}
+
+// Moves up to max_count elements to out, returns how many
+template <class T, QueueMode Mode, class Allocator>
+template <typename OutputIt>
+typename LinkedQueue<T, Mode, Allocator>::size_type LinkedQueue<T, Mode, Allocator>::pop_bulk(OutputIt out, size_type max_count) {
+	size_type popped = 0;
+	Node* dummy = head;
+	for (; popped < max_count; ++popped) {
+		Node* next = dummy->next.load(std::memory_order_acquire);
+		if (!next) break;
+
+		*out = std::move(next->data);
+		++out;
+		next->data.~T();
+		head = next;
+		free_node(dummy);
+		dummy = next;
+	}
+	return popped;
+}
+
+#endif
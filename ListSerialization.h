@@ -0,0 +1,297 @@
+//
+//  ListSerialization.h
+//  Data Structure - LinkedList
+//
+// Binary checkpoints for SingleLinkedList, DoubleLinkedList and any other
+// list with size(), iteration, push_back() and append_range().
+//
+// A file is a 32 byte header followed by the payload. A trivially copyable T
+// is written raw: the elements back to back, starting at an offset aligned
+// for T. Any other T is streamed one element at a time through
+// ListCodec<T>, which has to be specialized for it; std::string already is.
+//
+// load_mapped() maps the file and builds the list straight from the mapped
+// payload, with one append_range() per file, instead of going through a
+// stream. The nodes still own copies of the elements. The payload is read
+// once, so loading runs at about the speed of the allocator and the disk.
+// Files are only readable on a machine with the same byte order and, for raw
+// payloads, the same sizeof(T).
+//
+
+#ifndef LISTSERIALIZATION_h
+#define LISTSERIALIZATION_h
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LINKED_LISTS_HAS_MMAP 1
+#endif
+
+
+namespace detail {
+
+	// The payload is written and read in pieces of about this many bytes
+	constexpr std::size_t list_io_chunk = 1 << 16;
+}
+
+
+// Reads and writes one element of a T that is not trivially copyable. A read
+// that runs out of input leaves the stream failed
+template <class T, class = void>
+struct ListCodec;
+
+template <class CharT, class Traits, class Alloc>
+struct ListCodec<std::basic_string<CharT, Traits, Alloc>> {
+	using string_type = std::basic_string<CharT, Traits, Alloc>;
+
+	static void write(std::ostream &out, const string_type &value) {
+		const std::uint64_t length = value.size();
+		out.write(reinterpret_cast<const char*>(&length), sizeof length);
+		out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(length * sizeof(CharT)));
+	}
+
+	// The length comes from the file, so the string only grows as its characters
+	// actually arrive; a corrupt length runs into the end of the input instead of
+	// allocating whatever it claims
+	static string_type read(std::istream &in) {
+		std::uint64_t length = 0;
+		in.read(reinterpret_cast<char*>(&length), sizeof length);
+		string_type value;
+		constexpr std::size_t per_chunk = detail::list_io_chunk / sizeof(CharT) > 0 ? detail::list_io_chunk / sizeof(CharT) : 1;
+		for (std::uint64_t left = length; in && left != 0; ) {
+			const std::size_t batch = static_cast<std::size_t>(std::min<std::uint64_t>(per_chunk, left));
+			const std::size_t done = value.size();
+			value.resize(done + batch);
+			in.read(reinterpret_cast<char*>(&value[done]), static_cast<std::streamsize>(batch * sizeof(CharT)));
+			left -= batch;
+		}
+		return value;
+	}
+};
+
+
+namespace detail {
+
+	enum class ListEncoding : std::uint16_t {
+		Raw = 1,
+		Streamed = 2
+	};
+
+	struct ListFileHeader {
+		char magic[4];					// "LLST"
+		std::uint32_t byte_order;		// list_byte_order as the writer saw it
+		std::uint16_t version;
+		std::uint16_t encoding;			// ListEncoding
+		std::uint32_t element_size;		// sizeof(T) for raw payloads, 0 when streamed
+		std::uint64_t count;
+		std::uint64_t payload_offset;	// from the start of the header
+	};
+	static_assert(sizeof(ListFileHeader) == 32, "the header layout is part of the file format");
+
+	constexpr std::uint32_t list_byte_order = 0x01020304;
+	constexpr std::uint16_t list_file_version = 1;
+
+	template <class T>
+	constexpr bool raw_encoded = std::is_trivially_copyable<T>::value;
+
+	template <class T>
+	ListFileHeader make_list_header(std::uint64_t count) {
+		ListFileHeader header{ { 'L', 'L', 'S', 'T' }, list_byte_order, list_file_version, 0, 0, count, sizeof(ListFileHeader) };
+		if constexpr (raw_encoded<T>) {
+			header.encoding = static_cast<std::uint16_t>(ListEncoding::Raw);
+			header.element_size = sizeof(T);
+			header.payload_offset = (sizeof(ListFileHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+		}
+		else {
+			header.encoding = static_cast<std::uint16_t>(ListEncoding::Streamed);
+		}
+		return header;
+	}
+
+	// Throws unless header describes a file of T written on a compatible machine
+	template <class T>
+	void check_list_header(const ListFileHeader &header) {
+		const ListFileHeader expected = make_list_header<T>(0);
+		if (std::memcmp(header.magic, expected.magic, sizeof header.magic) != 0) throw std::runtime_error("Not a list file");
+		if (header.byte_order != list_byte_order) throw std::runtime_error("List file was written with a different byte order");
+		if (header.version != list_file_version) throw std::runtime_error("Unsupported list file version");
+		if (header.encoding != expected.encoding || header.element_size != expected.element_size) throw std::runtime_error("List file holds a different element type");
+		if (header.payload_offset < sizeof(ListFileHeader) || header.payload_offset % alignof(T) != 0) throw std::runtime_error("Corrupt list file header");
+	}
+
+	// Lets a stream read straight from memory, for streamed payloads in a mapped file
+	class MemoryStreamBuffer : public std::streambuf {
+	public:
+		MemoryStreamBuffer(const char* data, std::size_t size) {
+			char* begin = const_cast<char*>(data);
+			setg(begin, begin, begin + size);
+		}
+	};
+
+	// A read only view of a whole file, mapped where the platform allows it and read into memory elsewhere
+	class MappedFile {
+		const char* bytes = nullptr;
+		std::size_t length = 0;
+#ifdef LINKED_LISTS_HAS_MMAP
+		void* mapping = nullptr;
+#else
+		std::vector<char> contents;
+#endif
+
+	public:
+		explicit MappedFile(const char* path);
+		MappedFile(MappedFile const &) = delete;
+		MappedFile& operator=(MappedFile const &) = delete;
+		~MappedFile();
+
+		const char* data() const noexcept { return bytes; }
+		std::size_t size() const noexcept { return length; }
+	};
+
+#ifdef LINKED_LISTS_HAS_MMAP
+	inline MappedFile::MappedFile(const char* path) {
+		const int fd = ::open(path, O_RDONLY);
+		if (fd < 0) throw std::runtime_error(std::string("Could not open ") + path);
+
+		struct stat info;
+		if (::fstat(fd, &info) != 0) {
+			::close(fd);
+			throw std::runtime_error(std::string("Could not stat ") + path);
+		}
+		length = static_cast<std::size_t>(info.st_size);
+		if (length != 0) {
+			mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		::close(fd);
+		if (mapping == MAP_FAILED) {
+			mapping = nullptr;
+			throw std::runtime_error(std::string("Could not map ") + path);
+		}
+		if (mapping) ::madvise(mapping, length, MADV_SEQUENTIAL);
+		bytes = static_cast<const char*>(mapping);
+	}
+
+	inline MappedFile::~MappedFile() {
+		if (mapping) ::munmap(mapping, length);
+	}
+#else
+	inline MappedFile::MappedFile(const char* path) {
+		std::ifstream file{ path, std::ios::binary | std::ios::ate };
+		if (!file) throw std::runtime_error(std::string("Could not open ") + path);
+		contents.resize(static_cast<std::size_t>(file.tellg()));
+		file.seekg(0);
+		if (!file.read(contents.data(), static_cast<std::streamsize>(contents.size()))) throw std::runtime_error(std::string("Could not read ") + path);
+		bytes = contents.data();
+		length = contents.size();
+	}
+
+	inline MappedFile::~MappedFile() = default;
+#endif
+}
+
+
+template <class List>
+void serialize(std::ostream &out, const List &list) {
+	using T = typename List::value_type;
+	const detail::ListFileHeader header = detail::make_list_header<T>(list.size());
+	out.write(reinterpret_cast<const char*>(&header), sizeof header);
+	for (std::uint64_t pad = sizeof header; pad < header.payload_offset; ++pad) out.put('\0');
+
+	if constexpr (detail::raw_encoded<T>) {
+		// Gathers the scattered nodes into one buffer per write
+		constexpr std::size_t per_chunk = detail::list_io_chunk / sizeof(T) > 0 ? detail::list_io_chunk / sizeof(T) : 1;
+		std::vector<char> buffer(per_chunk * sizeof(T));
+		std::size_t used = 0;
+		for (const T& item : list) {
+			std::memcpy(buffer.data() + used * sizeof(T), std::addressof(item), sizeof(T));
+			if (++used == per_chunk) {
+				out.write(buffer.data(), static_cast<std::streamsize>(used * sizeof(T)));
+				used = 0;
+			}
+		}
+		out.write(buffer.data(), static_cast<std::streamsize>(used * sizeof(T)));
+	}
+	else {
+		for (const T& item : list) ListCodec<T>::write(out, item);
+	}
+
+	if (!out) throw std::runtime_error("Could not write the list");
+}
+
+// Replaces the contents of list, which is left unchanged if reading fails
+template <class List>
+void deserialize(std::istream &in, List &list) {
+	using T = typename List::value_type;
+	detail::ListFileHeader header;
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof header)) throw std::runtime_error("Could not read the list header");
+	detail::check_list_header<T>(header);
+	in.ignore(static_cast<std::streamsize>(header.payload_offset - sizeof header));
+
+	List loaded(list.get_allocator());
+	if constexpr (detail::raw_encoded<T>) {
+		using storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+		constexpr std::size_t per_chunk = detail::list_io_chunk / sizeof(T) > 0 ? detail::list_io_chunk / sizeof(T) : 1;
+		std::vector<storage> buffer(static_cast<std::size_t>(std::min<std::uint64_t>(per_chunk, header.count)));
+		for (std::uint64_t left = header.count; left != 0; ) {
+			const std::size_t batch = static_cast<std::size_t>(std::min<std::uint64_t>(per_chunk, left));
+			if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(batch * sizeof(T)))) throw std::runtime_error("List file is truncated");
+			const T* items = reinterpret_cast<const T*>(buffer.data());
+			loaded.append_range(items, items + batch);
+			left -= batch;
+		}
+	}
+	else {
+		for (std::uint64_t i = 0; i < header.count; ++i) {
+			T item = ListCodec<T>::read(in);
+			if (!in) throw std::runtime_error("List file is truncated");
+			loaded.push_back(std::move(item));
+		}
+	}
+	list.swap(loaded);
+}
+
+template <class List>
+void serialize(const char* path, const List &list) {
+	std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+	if (!out) throw std::runtime_error(std::string("Could not create ") + path);
+	serialize(out, list);
+}
+
+template <class List>
+void deserialize(const char* path, List &list) {
+	std::ifstream in{ path, std::ios::binary };
+	if (!in) throw std::runtime_error(std::string("Could not open ") + path);
+	deserialize(in, list);
+}
+
+// Like deserialize(path, list), but builds the list from the mapped file without copying it through a stream
+template <class List>
+void load_mapped(const char* path, List &list) {
+	using T = typename List::value_type;
+	const detail::MappedFile file{ path };
+
+	detail::ListFileHeader header;
+	if (file.size() < sizeof header) throw std::runtime_error("Could not read the list header");
+	std::memcpy(&header, file.data(), sizeof header);
+	detail::check_list_header<T>(header);
+	if (header.payload_offset > file.size()) throw std::runtime_error("List file is truncated");
+
+	if constexpr (detail::raw_encoded<T>) {
+		if ((file.size() - header.payload_offset) / sizeof(T) < header.count) throw std::runtime_error("List file is truncated");
+
+		// The mapping is page aligned and the payload offset is aligned for T
+		const T* items = reinterpret_cast<const T*>(file.data() + header.payload_offset);
+		List loaded(list.get_allocator());
+		loaded.append_range(items, items + header.count);
+		list.swap(loaded);
+	}
+	else {
+		detail::MemoryStreamBuffer buffer{ file.data(), file.size() };
+		std::istream in{ &buffer };
+		deserialize(in, list);
+	}
+}
+
+#endif
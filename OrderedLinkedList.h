@@ -0,0 +1,430 @@
+//
+//  OrderedLinkedList.h
+//  Data Structure - LinkedList
+//
+// A sorted singly linked list with a skip list index on top. The bottom level
+// is the plain chain, walked by the iterators in Compare order. About one node
+// in four also sits on level 1, one in sixteen on level 2 and so on, and a
+// lookup runs along the highest of these express lanes first, dropping a
+// level each time it would overshoot. lower_bound, find, insert_sorted and
+// erase take O(log n) expected steps instead of a walk over the whole chain.
+//
+// Elements equal under Compare are kept in insertion order. The elements are
+// const through the iterators since changing one could break the order.
+//
+
+#ifndef ORDEREDLINKEDLIST_h
+#define ORDEREDLINKEDLIST_h
+
+
+template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>>
+class OrderedLinkedList {
+private:
+
+	struct Node;
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+	using lane_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node*>;
+	using lane_traits = std::allocator_traits<lane_allocator>;
+
+	static constexpr int max_height = 32;
+
+	template <typename InputIt>
+	using RequireInputIterator = std::enable_if_t<std::is_convertible<
+		typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>::value>;
+
+	struct Node {
+		T data;
+		Node* next = nullptr;		// level 0
+		Node** lanes = nullptr;		// levels 1 to height - 1
+		int height;
+
+		template<typename... Args>
+		explicit Node(int height, Args&&... args) : data{ std::forward<Args>(args)... }, height{ height } {}
+	};
+
+	Node* head[max_height] = {};	// head[0] starts the bottom chain
+	int height = 1;					// levels in use
+	std::size_t length = 0;
+	std::uint64_t seed = 0x9E3779B97F4A7C15ull;
+	Compare comp;
+	node_allocator alloc;
+
+	// The link leaving node on level, the head's if node is null
+	Node*& link(Node* node, int level) noexcept {
+		if (!node) return head[level];
+		return level == 0 ? node->next : node->lanes[level - 1];
+	}
+	Node* link(const Node* node, int level) const noexcept {
+		if (!node) return head[level];
+		return level == 0 ? node->next : node->lanes[level - 1];
+	}
+
+	int random_height() noexcept;
+
+	template <typename... Args>
+	Node* make_node(int height, Args&&... args);
+	void free_node(Node* node) noexcept;
+
+	template <bool Upper>
+	Node* descend(const T &x, Node** update) const;
+
+	void link_node(Node* node, Node** update) noexcept;
+	void unlink_node(Node* node, Node** update) noexcept;
+
+public:
+	// Constructors
+	using value_type = T;
+	using value_compare = Compare;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	OrderedLinkedList() = default;
+	explicit OrderedLinkedList(const Compare &comp, const Allocator &alloc = Allocator());
+	OrderedLinkedList(OrderedLinkedList const &source);
+	OrderedLinkedList(std::initializer_list<T> init, const Compare &comp = Compare(), const Allocator &alloc = Allocator());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	OrderedLinkedList(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator());
+
+	OrderedLinkedList(OrderedLinkedList &&move) noexcept;
+	OrderedLinkedList& operator=(OrderedLinkedList &&move) noexcept;
+	OrderedLinkedList& operator=(OrderedLinkedList const &rhs);
+	~OrderedLinkedList() noexcept;
+
+	// Only const iteration, see above
+	class const_iterator;
+	using iterator = const_iterator;
+	const_iterator begin() const noexcept { return { head[0] }; }
+	const_iterator end() const noexcept { return {}; }
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+
+	// Memeber functions
+	void swap(OrderedLinkedList &other) noexcept;
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+	value_compare value_comp() const { return comp; }
+	bool empty() const noexcept { return head[0] == nullptr; }
+	size_type size() const noexcept { return length; }
+	const T& front() const { return head[0]->data; }
+
+	template<typename... Args>
+	const_iterator emplace_sorted(Args&&... args);
+
+	const_iterator insert_sorted(const T &theData);
+	const_iterator insert_sorted(T &&theData);
+
+	const_iterator lower_bound(const T &x) const;
+	const_iterator upper_bound(const T &x) const;
+	const_iterator find(const T &x) const;
+	bool search(const T &x) const { return find(x) != end(); }
+	size_type count(const T &x) const;
+
+	bool erase(const T &x);
+	const_iterator erase(const_iterator pos);
+	void pop_front();
+	void clear() noexcept;
+};
+
+template <class T, class Compare, class Allocator>
+class OrderedLinkedList<T, Compare, Allocator>::const_iterator {
+	Node* node = nullptr;
+
+public:
+	friend class OrderedLinkedList<T, Compare, Allocator>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T * ;
+	using reference = const T & ;
+
+	const_iterator(Node* node = nullptr) : node{ node } {}
+
+	bool operator!=(const_iterator other) const noexcept { return node != other.node; }
+	bool operator==(const_iterator other) const noexcept { return node == other.node; }
+
+	const T& operator*() const { return node->data; }
+	const T* operator->() const { return &node->data; }
+
+	const_iterator& operator++() { node = node->next; return *this; }
+	const_iterator operator++(int) { auto copy = *this; node = node->next; return copy; }
+};
+
+
+template <class T, class Compare, class Allocator>
+OrderedLinkedList<T, Compare, Allocator>::OrderedLinkedList(const Compare &comp, const Allocator &alloc) : comp{ comp }, alloc{ alloc } {}
+
+// The source is sorted already, so every node goes straight on the end of each of its levels
+template <class T, class Compare, class Allocator>
+OrderedLinkedList<T, Compare, Allocator>::OrderedLinkedList(OrderedLinkedList const &source)
+	: comp{ source.comp }, alloc{ node_traits::select_on_container_copy_construction(source.alloc) } {
+	Node* last[max_height] = {};
+	try {
+		for (const Node* from = source.head[0]; from != nullptr; from = from->next) {
+			Node* node = make_node(from->height, from->data);
+			for (int level = 0; level < node->height; ++level) {
+				link(last[level], level) = node;
+				last[level] = node;
+			}
+			++length;
+		}
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+	height = source.height;
+}
+
+template <class T, class Compare, class Allocator>
+OrderedLinkedList<T, Compare, Allocator>::OrderedLinkedList(std::initializer_list<T> init, const Compare &comp, const Allocator &alloc)
+	: OrderedLinkedList(init.begin(), init.end(), comp, alloc) {}
+
+template <class T, class Compare, class Allocator>
+template <typename InputIt, typename>
+OrderedLinkedList<T, Compare, Allocator>::OrderedLinkedList(InputIt first, InputIt last, const Compare &comp, const Allocator &alloc)
+	: comp{ comp }, alloc{ alloc } {
+	try {
+		for (; first != last; ++first) insert_sorted(*first);
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+}
+
+template <class T, class Compare, class Allocator>
+OrderedLinkedList<T, Compare, Allocator>::OrderedLinkedList(OrderedLinkedList &&move) noexcept {
+	move.swap(*this);
+}
+
+template <class T, class Compare, class Allocator>
+OrderedLinkedList<T, Compare, Allocator>& OrderedLinkedList<T, Compare, Allocator>::operator=(OrderedLinkedList &&move) noexcept {
+	move.swap(*this);
+	return *this;
+}
+
+template <class T, class Compare, class Allocator>
+OrderedLinkedList<T, Compare, Allocator>& OrderedLinkedList<T, Compare, Allocator>::operator=(OrderedLinkedList const &rhs) {
+	OrderedLinkedList copy{ rhs };
+	swap(copy);
+	return *this;
+}
+
+template <class T, class Compare, class Allocator>
+OrderedLinkedList<T, Compare, Allocator>::~OrderedLinkedList() noexcept {
+	clear();
+}
+
+template <class T, class Compare, class Allocator>
+void OrderedLinkedList<T, Compare, Allocator>::swap(OrderedLinkedList &other) noexcept {
+	using std::swap;
+	swap(head, other.head);
+	swap(height, other.height);
+	swap(length, other.length);
+	swap(seed, other.seed);
+	swap(comp, other.comp);
+	swap(alloc, other.alloc);
+}
+
+// Each extra level with probability 1/4, two random bits per level
+template <class T, class Compare, class Allocator>
+int OrderedLinkedList<T, Compare, Allocator>::random_height() noexcept {
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+
+	std::uint64_t bits = seed;
+	int levels = 1;
+	while (levels < max_height && (bits & 3) == 0) {
+		++levels;
+		bits >>= 2;
+	}
+	return levels;
+}
+
+template <class T, class Compare, class Allocator>
+template <typename... Args>
+typename OrderedLinkedList<T, Compare, Allocator>::Node* OrderedLinkedList<T, Compare, Allocator>::make_node(int levels, Args&&... args) {
+	lane_allocator lane_alloc{ alloc };
+	Node** lanes = levels > 1 ? lane_traits::allocate(lane_alloc, std::size_t(levels - 1)) : nullptr;
+
+	Node* node = nullptr;
+	try {
+		node = node_traits::allocate(alloc, 1);
+		node_traits::construct(alloc, node, levels, std::forward<Args>(args)...);
+	}
+	catch (...) {
+		if (node) node_traits::deallocate(alloc, node, 1);
+		if (lanes) lane_traits::deallocate(lane_alloc, lanes, std::size_t(levels - 1));
+		throw;
+	}
+
+	node->lanes = lanes;
+	for (int level = 1; level < levels; ++level) node->lanes[level - 1] = nullptr;
+	return node;
+}
+
+template <class T, class Compare, class Allocator>
+void OrderedLinkedList<T, Compare, Allocator>::free_node(Node* node) noexcept {
+	if (node->lanes) {
+		lane_allocator lane_alloc{ alloc };
+		lane_traits::deallocate(lane_alloc, node->lanes, std::size_t(node->height - 1));
+	}
+	node_traits::destroy(alloc, node);
+	node_traits::deallocate(alloc, node, 1);
+}
+
+// Runs down from the top level and returns the first node not before x (or
+// after x when Upper is set). update, if given, receives the last node before
+// that point on every level, null meaning the head.
+template <class T, class Compare, class Allocator>
+template <bool Upper>
+typename OrderedLinkedList<T, Compare, Allocator>::Node* OrderedLinkedList<T, Compare, Allocator>::descend(const T &x, Node** update) const {
+	Node* previous = nullptr;
+	for (int level = height - 1; level >= 0; --level) {
+		for (Node* next = link(previous, level); next != nullptr; next = link(previous, level)) {
+			const bool before = Upper ? !comp(x, next->data) : comp(next->data, x);
+			if (!before) break;
+			previous = next;
+		}
+		if (update) update[level] = previous;
+	}
+	return link(previous, 0);
+}
+
+template <class T, class Compare, class Allocator>
+void OrderedLinkedList<T, Compare, Allocator>::link_node(Node* node, Node** update) noexcept {
+	for (; height < node->height; ++height) update[height] = nullptr;
+
+	for (int level = 0; level < node->height; ++level) {
+		Node*& previous_link = link(update[level], level);
+		link(node, level) = previous_link;
+		previous_link = node;
+	}
+	++length;
+}
+
+// update holds, per level, a node before node or the head
+template <class T, class Compare, class Allocator>
+void OrderedLinkedList<T, Compare, Allocator>::unlink_node(Node* node, Node** update) noexcept {
+	for (int level = 0; level < node->height; ++level) {
+		Node* previous = update[level];
+		while (link(previous, level) != node) previous = link(previous, level);	// steps over equal elements only
+		link(previous, level) = link(node, level);
+	}
+	while (height > 1 && head[height - 1] == nullptr) --height;
+	--length;
+}
+
+template <class T, class Compare, class Allocator>
+template <typename... Args>
+typename OrderedLinkedList<T, Compare, Allocator>::const_iterator OrderedLinkedList<T, Compare, Allocator>::emplace_sorted(Args&&... args) {
+	Node* node = make_node(random_height(), std::forward<Args>(args)...);
+
+	Node* update[max_height];
+	try {
+		descend<true>(node->data, update);
+	}
+	catch (...) {
+		free_node(node);
+		throw;
+	}
+	link_node(node, update);
+	return { node };
+}
+
+template <class T, class Compare, class Allocator>
+typename OrderedLinkedList<T, Compare, Allocator>::const_iterator OrderedLinkedList<T, Compare, Allocator>::insert_sorted(const T &theData) {
+	return emplace_sorted(theData);
+}
+
+template <class T, class Compare, class Allocator>
+typename OrderedLinkedList<T, Compare, Allocator>::const_iterator OrderedLinkedList<T, Compare, Allocator>::insert_sorted(T &&theData) {
+	return emplace_sorted(std::move(theData));
+}
+
+template <class T, class Compare, class Allocator>
+typename OrderedLinkedList<T, Compare, Allocator>::const_iterator OrderedLinkedList<T, Compare, Allocator>::lower_bound(const T &x) const {
+	return { descend<false>(x, nullptr) };
+}
+
+template <class T, class Compare, class Allocator>
+typename OrderedLinkedList<T, Compare, Allocator>::const_iterator OrderedLinkedList<T, Compare, Allocator>::upper_bound(const T &x) const {
+	return { descend<true>(x, nullptr) };
+}
+
+template <class T, class Compare, class Allocator>
+typename OrderedLinkedList<T, Compare, Allocator>::const_iterator OrderedLinkedList<T, Compare, Allocator>::find(const T &x) const {
+	Node* node = descend<false>(x, nullptr);
+	if (node && !comp(x, node->data)) return { node };
+	return end();
+}
+
+template <class T, class Compare, class Allocator>
+typename OrderedLinkedList<T, Compare, Allocator>::size_type OrderedLinkedList<T, Compare, Allocator>::count(const T &x) const {
+	size_type found = 0;
+	for (Node* node = descend<false>(x, nullptr); node != nullptr && !comp(x, node->data); node = node->next) {
+		++found;
+	}
+	return found;
+}
+
+// Erases the first element equal to x, returns whether there was one
+template <class T, class Compare, class Allocator>
+bool OrderedLinkedList<T, Compare, Allocator>::erase(const T &x) {
+	Node* update[max_height];
+	Node* node = descend<false>(x, update);
+	if (!node || comp(x, node->data)) return false;
+
+	unlink_node(node, update);
+	free_node(node);
+	return true;
+}
+
+template <class T, class Compare, class Allocator>
+typename OrderedLinkedList<T, Compare, Allocator>::const_iterator OrderedLinkedList<T, Compare, Allocator>::erase(const_iterator pos) {
+	Node* node = pos.node;
+	Node* update[max_height];
+	descend<false>(node->data, update);
+
+	Node* next = node->next;
+	unlink_node(node, update);
+	free_node(node);
+	return { next };
+}
+
+template <class T, class Compare, class Allocator>
+void OrderedLinkedList<T, Compare, Allocator>::pop_front() {
+	if (empty()) {
+		return;
+	}
+	Node* update[max_height] = {};
+	Node* node = head[0];
+	unlink_node(node, update);
+	free_node(node);
+}
+
+template <class T, class Compare, class Allocator>
+void OrderedLinkedList<T, Compare, Allocator>::clear() noexcept {
+	Node* current = head[0];
+	while (current) {
+		Node* next = current->next;
+		free_node(current);
+		current = next;
+	}
+	for (Node*& first : head) first = nullptr;
+	height = 1;
+	length = 0;
+}
+
+template <class T, class Compare, class Allocator>
+std::ostream& operator<<(std::ostream &str, const OrderedLinkedList<T, Compare, Allocator>& list) {
+	for (auto const& item : list) {
+		str << item << "\t";
+	}
+	return str;
+}
+
+#endif
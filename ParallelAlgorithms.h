@@ -0,0 +1,189 @@
+//
+//  ParallelAlgorithms.h
+//  Data Structure - LinkedList
+//
+// for_each, transform, reduce, count_if and find_if over a whole list, split
+// across a WorkStealingPool.
+//
+// A linked list cannot be cut at arbitrary positions, so one walk over the
+// chain first records an iterator at every segment boundary (a
+// ListPartition), and the segments then run as separate tasks. That walk
+// only touches the links, while the algorithm touches every element, so it
+// pays off once the per-element work is more than a pointer chase. A
+// ListPartition can also be kept and passed in place of the list, to skip
+// the walk when several algorithms run over the same unchanged list.
+//
+// Works with any list that has begin(), end() and size(), SingleLinkedList
+// and DoubleLinkedList included. The list must not change while an algorithm
+// runs, and a kept partition is only valid until the list's links change.
+//
+
+#ifndef PARALLELALGORITHMS_h
+#define PARALLELALGORITHMS_h
+
+#include "WorkStealingPool.h"
+
+
+template <class Iterator>
+class ListPartition {
+	std::vector<Iterator> bounds;		// segments() + 1 iterators, the last one is end()
+	std::size_t length = 0;
+
+public:
+	using iterator = Iterator;
+	using size_type = std::size_t;
+
+	// Splits list into segments runs whose lengths differ by at most one, in one walk
+	template <class List>
+	ListPartition(List &list, size_type segments);
+
+	size_type segments() const noexcept { return bounds.size() - 1; }
+	size_type size() const noexcept { return length; }
+	Iterator begin() const { return bounds.front(); }
+	Iterator end() const { return bounds.back(); }
+	Iterator segment_begin(size_type segment) const { return bounds[segment]; }
+	Iterator segment_end(size_type segment) const { return bounds[segment + 1]; }
+};
+
+template <class Iterator>
+template <class List>
+ListPartition<Iterator>::ListPartition(List &list, size_type segments) : length{ list.size() } {
+	if (segments > length) segments = length;
+	if (segments == 0) segments = 1;
+
+	bounds.reserve(segments + 1);
+	Iterator it = list.begin();
+	bounds.push_back(it);
+	const size_type step = length / segments, longer = length % segments;
+	for (size_type segment = 0; segment + 1 < segments; ++segment) {
+		for (size_type i = step + (segment < longer ? 1 : 0); i != 0; --i) ++it;
+		bounds.push_back(it);
+	}
+	bounds.push_back(list.end());
+}
+
+template <class List>
+ListPartition<decltype(std::declval<List&>().begin())> make_partition(List &list, std::size_t segments) {
+	return { list, segments };
+}
+
+
+namespace parallel {
+
+	namespace detail {
+
+		template <class T>
+		struct is_partition : std::false_type {};
+
+		template <class Iterator>
+		struct is_partition<ListPartition<Iterator>> : std::true_type {};
+
+		template <class Range>
+		using iterator_of = decltype(std::declval<Range&>().begin());
+
+		// Below this many elements a segment is not worth a task of its own
+		constexpr std::size_t min_segment = 2048;
+
+		// A few segments per thread, so threads that finish early can steal the rest. Without
+		// workers a single segment needs no walk at all
+		inline std::size_t segments_for(std::size_t length, const WorkStealingPool &pool) {
+			if (pool.concurrency() == 1) return 1;
+			const std::size_t wanted = std::size_t(pool.concurrency()) * 4;
+			const std::size_t most = (length + min_segment - 1) / min_segment;
+			return wanted < most ? wanted : most;
+		}
+
+		// Calls body with range itself when it is already a partition, otherwise with a fresh one
+		template <class Range, class Body>
+		decltype(auto) with_partition(Range &range, WorkStealingPool &pool, Body &&body) {
+			if constexpr (is_partition<std::remove_const_t<Range>>::value) {
+				return body(range);
+			}
+			else {
+				return body(make_partition(range, segments_for(range.size(), pool)));
+			}
+		}
+	}
+
+	template <class Range, class Function>
+	void for_each(Range &range, Function f, WorkStealingPool &pool = WorkStealingPool::instance()) {
+		detail::with_partition(range, pool, [&](const auto &part) {
+			pool.run(part.segments(), [&](std::size_t segment) {
+				for (auto it = part.segment_begin(segment), last = part.segment_end(segment); it != last; ++it) f(*it);
+			});
+		});
+	}
+
+	// In place, every element becomes op(element)
+	template <class Range, class UnaryOperation>
+	void transform(Range &range, UnaryOperation op, WorkStealingPool &pool = WorkStealingPool::instance()) {
+		detail::with_partition(range, pool, [&](const auto &part) {
+			pool.run(part.segments(), [&](std::size_t segment) {
+				for (auto it = part.segment_begin(segment), last = part.segment_end(segment); it != last; ++it) *it = op(*it);
+			});
+		});
+	}
+
+	// op has to be associative, the segments are folded separately and then combined in order
+	template <class Range, class T, class BinaryOperation = std::plus<>>
+	T reduce(const Range &range, T init, BinaryOperation op = BinaryOperation(), WorkStealingPool &pool = WorkStealingPool::instance()) {
+		return detail::with_partition(range, pool, [&](const auto &part) {
+			if (part.size() == 0) return init;
+
+			std::vector<T> partial;
+			partial.reserve(part.segments());
+			for (std::size_t segment = 0; segment < part.segments(); ++segment) partial.emplace_back(*part.segment_begin(segment));
+
+			pool.run(part.segments(), [&](std::size_t segment) {
+				T& sum = partial[segment];
+				for (auto it = std::next(part.segment_begin(segment)), last = part.segment_end(segment); it != last; ++it) sum = op(std::move(sum), *it);
+			});
+
+			T result = std::move(init);
+			for (T& sum : partial) result = op(std::move(result), std::move(sum));
+			return result;
+		});
+	}
+
+	template <class Range, class Predicate>
+	std::size_t count_if(const Range &range, Predicate pred, WorkStealingPool &pool = WorkStealingPool::instance()) {
+		return detail::with_partition(range, pool, [&](const auto &part) {
+			std::vector<std::size_t> counts(part.segments(), 0);
+			pool.run(part.segments(), [&](std::size_t segment) {
+				std::size_t matches = 0;
+				for (auto it = part.segment_begin(segment), last = part.segment_end(segment); it != last; ++it) {
+					if (pred(*it)) ++matches;
+				}
+				counts[segment] = matches;
+			});
+			return std::accumulate(counts.begin(), counts.end(), std::size_t(0));
+		});
+	}
+
+	// The first match in list order, segments after one that already matched give up early
+	template <class Range, class Predicate>
+	detail::iterator_of<Range> find_if(Range &range, Predicate pred, WorkStealingPool &pool = WorkStealingPool::instance()) {
+		return detail::with_partition(range, pool, [&](const auto &part) {
+			using iterator = detail::iterator_of<Range>;
+			std::vector<iterator> found(part.segments(), part.end());
+			std::atomic<std::size_t> first_match{ part.segments() };
+
+			pool.run(part.segments(), [&](std::size_t segment) {
+				for (auto it = part.segment_begin(segment), last = part.segment_end(segment); it != last; ++it) {
+					if (first_match.load(std::memory_order_relaxed) < segment) return;
+					if (pred(*it)) {
+						found[segment] = it;
+						std::size_t current = first_match.load(std::memory_order_relaxed);
+						while (segment < current && !first_match.compare_exchange_weak(current, segment, std::memory_order_relaxed)) {}
+						return;
+					}
+				}
+			});
+
+			const std::size_t segment = first_match.load(std::memory_order_relaxed);
+			return segment < part.segments() ? iterator(found[segment]) : iterator(part.end());
+		});
+	}
+}
+
+#endif
@@ -0,0 +1,300 @@
+//
+//  PersistentList.h
+//  Data Structure - LinkedList
+//
+// An immutable singly linked list. push_front() and pop_front() leave the
+// list alone and return a new version that shares every node after the front
+// with the old one, so a version is just a pointer to its first node and
+// copying it is O(1).
+//
+// Nodes are reference counted. The count is atomic, so versions that share
+// nodes can be copied, read and dropped on different threads without a lock.
+// A single PersistentList object is no more thread safe than a shared_ptr:
+// assigning to it while another thread reads that same object is a race, so
+// publish new versions through a mutex or an atomic swap and hand readers
+// their own copy.
+//
+
+#ifndef PERSISTENTLIST_h
+#define PERSISTENTLIST_h
+
+
+template <class T, class Allocator = std::allocator<T>>
+class PersistentList {
+private:
+
+	struct Node {
+		std::atomic<std::size_t> refs{ 1 };
+		Node* next;
+		T data;
+
+		template<typename... Args>
+		explicit Node(Node* next, Args&&... args) : next{ next }, data(std::forward<Args>(args)...) {}
+	};
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
+	template <typename InputIt>
+	using RequireInputIterator = std::enable_if_t<std::is_convertible<
+		typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>::value>;
+
+	Node* head = nullptr;
+	std::size_t length = 0;
+	node_allocator alloc;
+
+	PersistentList(Node* head, std::size_t length, const node_allocator &alloc) noexcept : head{ head }, length{ length }, alloc{ alloc } {}
+
+	static Node* retain(Node* node) noexcept {
+		if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+		return node;
+	}
+	void release(Node* node) noexcept;
+
+	template <typename... Args>
+	Node* make_node(Node* next, Args&&... args);
+
+public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	// Constructors
+	explicit PersistentList(const Allocator &alloc = Allocator()) : alloc{ alloc } {}
+	PersistentList(std::initializer_list<T> init, const Allocator &alloc = Allocator());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	PersistentList(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+
+																		// Rule of 5
+	PersistentList(PersistentList const &source) noexcept;				// Copy constructor, shares every node
+	PersistentList(PersistentList &&move) noexcept;						// Move constructor
+	PersistentList& operator=(PersistentList const &rhs) noexcept;		// Copy assignment operator
+	PersistentList& operator=(PersistentList &&move) noexcept;			// Move assignment operator
+	~PersistentList() noexcept;
+
+	// Only a const iterator, the elements of a version never change
+	class const_iterator;
+	using iterator = const_iterator;
+	const_iterator begin() const noexcept { return const_iterator{ head }; }
+	const_iterator end() const noexcept { return const_iterator{}; }
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+
+	// Memeber functions
+	void swap(PersistentList &other) noexcept;
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+	bool empty() const noexcept { return head == nullptr; }
+	size_type size() const noexcept { return length; }
+	const T& front() const { return head->data; }
+
+	// New versions, the list itself is left unchanged
+	template<typename... Args>
+	PersistentList emplace_front(Args&&... args) const;
+	PersistentList push_front(const T &theData) const;
+	PersistentList push_front(T &&theData) const;
+	PersistentList pop_front() const;
+	PersistentList reverse() const;
+
+	bool search(const T &x) const;
+	size_type count(const T &x) const;
+	void clear() noexcept;
+
+	// True when both lists start at the same node, which makes them equal without looking at the elements
+	bool shares_with(const PersistentList &other) const noexcept { return head == other.head; }
+
+	template <class U, class A>
+	friend bool operator==(const PersistentList<U, A> &lhs, const PersistentList<U, A> &rhs);
+};
+
+template <class T, class Allocator>
+class PersistentList<T, Allocator>::const_iterator {
+	const Node* node = nullptr;
+
+public:
+	friend class PersistentList<T, Allocator>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T * ;
+	using reference = const T & ;
+
+	const_iterator() = default;
+	explicit const_iterator(const Node* node) : node{ node } {}
+
+	bool operator!=(const_iterator other) const noexcept { return node != other.node; }
+	bool operator==(const_iterator other) const noexcept { return node == other.node; }
+
+	const T& operator*() const { return node->data; }
+	const T* operator->() const { return &node->data; }
+
+	const_iterator& operator++() { node = node->next; return *this; }
+	const_iterator operator++(int) { auto copy = *this; ++*this; return copy; }
+};
+
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::PersistentList(std::initializer_list<T> init, const Allocator &alloc) : PersistentList(init.begin(), init.end(), alloc) {}
+
+// Builds the chain front to back through a pointer to the last link
+template <class T, class Allocator>
+template <typename InputIt, typename>
+PersistentList<T, Allocator>::PersistentList(InputIt first, InputIt last, const Allocator &alloc) : alloc{ alloc } {
+	Node** link = &head;
+	try {
+		for (; first != last; ++first) {
+			*link = make_node(nullptr, *first);
+			link = &(*link)->next;
+			++length;
+		}
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::PersistentList(PersistentList const &source) noexcept
+	: head{ retain(source.head) }, length{ source.length }, alloc{ source.alloc } {}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::PersistentList(PersistentList &&move) noexcept
+	: head{ move.head }, length{ move.length }, alloc{ move.alloc } {
+	move.head = nullptr;
+	move.length = 0;
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>& PersistentList<T, Allocator>::operator=(PersistentList const &rhs) noexcept {
+	PersistentList copy{ rhs };
+	swap(copy);
+	return *this;
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>& PersistentList<T, Allocator>::operator=(PersistentList &&move) noexcept {
+	PersistentList taken{ std::move(move) };
+	swap(taken);
+	return *this;
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator>::~PersistentList() noexcept {
+	release(head);
+}
+
+template <class T, class Allocator>
+void PersistentList<T, Allocator>::swap(PersistentList &other) noexcept {
+	using std::swap;
+	swap(head, other.head);
+	swap(length, other.length);
+	swap(alloc, other.alloc);
+}
+
+// Drops one reference and frees the nodes nobody else holds, iteratively so a long chain cannot overflow the stack
+template <class T, class Allocator>
+void PersistentList<T, Allocator>::release(Node* node) noexcept {
+	while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		Node* next = node->next;
+		node_traits::destroy(alloc, node);
+		node_traits::deallocate(alloc, node, 1);
+		node = next;
+	}
+}
+
+// The new node takes over the caller's reference to next
+template <class T, class Allocator>
+template <typename... Args>
+typename PersistentList<T, Allocator>::Node* PersistentList<T, Allocator>::make_node(Node* next, Args&&... args) {
+	Node* node = node_traits::allocate(alloc, 1);
+	try {
+		node_traits::construct(alloc, node, next, std::forward<Args>(args)...);
+	}
+	catch (...) {
+		node_traits::deallocate(alloc, node, 1);
+		throw;
+	}
+	return node;
+}
+
+template <class T, class Allocator>
+template <typename... Args>
+PersistentList<T, Allocator> PersistentList<T, Allocator>::emplace_front(Args&&... args) const {
+	PersistentList pushed{ nullptr, length + 1, alloc };
+	pushed.head = pushed.make_node(head, std::forward<Args>(args)...);
+	retain(head);
+	return pushed;
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator> PersistentList<T, Allocator>::push_front(const T &theData) const {
+	return emplace_front(theData);
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator> PersistentList<T, Allocator>::push_front(T &&theData) const {
+	return emplace_front(std::move(theData));
+}
+
+template <class T, class Allocator>
+PersistentList<T, Allocator> PersistentList<T, Allocator>::pop_front() const {
+	if (empty()) {
+		return *this;
+	}
+	return PersistentList{ retain(head->next), length - 1, alloc };
+}
+
+// Nothing can be shared, the result is a fresh chain
+template <class T, class Allocator>
+PersistentList<T, Allocator> PersistentList<T, Allocator>::reverse() const {
+	PersistentList reversed{ nullptr, 0, alloc };
+	for (const T& item : *this) {
+		reversed.head = reversed.make_node(reversed.head, item);
+		++reversed.length;
+	}
+	return reversed;
+}
+
+template <class T, class Allocator>
+bool PersistentList<T, Allocator>::search(const T &x) const {
+	return std::find(begin(), end(), x) != end();
+}
+
+template <class T, class Allocator>
+typename PersistentList<T, Allocator>::size_type PersistentList<T, Allocator>::count(const T &x) const {
+	return static_cast<size_type>(std::count(begin(), end(), x));
+}
+
+template <class T, class Allocator>
+void PersistentList<T, Allocator>::clear() noexcept {
+	release(head);
+	head = nullptr;
+	length = 0;
+}
+
+// Stops comparing as soon as both sides reach a node they share
+template <class T, class Allocator>
+bool operator==(const PersistentList<T, Allocator> &lhs, const PersistentList<T, Allocator> &rhs) {
+	if (lhs.length != rhs.length) return false;
+	auto left = lhs.head, right = rhs.head;
+	for (; left != right; left = left->next, right = right->next) {
+		if (!(left->data == right->data)) return false;
+	}
+	return true;
+}
+
+template <class T, class Allocator>
+bool operator!=(const PersistentList<T, Allocator> &lhs, const PersistentList<T, Allocator> &rhs) {
+	return !(lhs == rhs);
+}
+
+template <class T, class Allocator>
+std::ostream& operator<<(std::ostream &str, const PersistentList<T, Allocator>& list) {
+	for (auto const& item : list) {
+		str << item << "\t";
+	}
+	return str;
+}
+
+#endif
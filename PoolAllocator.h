@@ -0,0 +1,309 @@
+//
+//  PoolAllocator.h
+//  Data Structure - LinkedList
+//
+// A node pool for the list templates. Single-object requests are carved out of
+// large chunks and recycled through a free list, so building and tearing down
+// a list does not go through the global heap once the pool is warm.
+//
+// The allocator is stateless: every PoolAllocator rebound to the same node size
+// shares one pool, so nodes never carry a copy of the allocator around.
+// Each thread keeps its own free list; chunks are shared and live for the rest
+// of the process.
+//
+// deallocate_chain() frees a whole linked run of objects in one call. Long
+// runs of frees with no allocation in between go to the shared pool, so a
+// thread that only ever frees (a reclaimer or a queue consumer, say) does not
+// end up hoarding nodes the others could reuse.
+//
+// allocate_fresh() skips the free list and hands out the untouched slots of a
+// chunk one after the other, so consecutive calls return adjacent objects.
+// Lists use it to lay their nodes out again in list order.
+//
+
+#ifndef POOLALLOCATOR_h
+#define POOLALLOCATOR_h
+
+
+namespace detail {
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+class NodePool {
+private:
+
+	union Slot {
+		Slot* next;
+		alignas(Align) unsigned char storage[Size];
+	};
+
+	// Chunks and the free slots of threads that have exited
+	struct Shared {
+		std::mutex mutex;
+		std::vector<Slot*> chunks;
+		Slot* spare = nullptr;
+		Slot* spare_last = nullptr;
+	};
+
+	struct Cache {
+		Slot* free = nullptr;
+		Slot* free_last = nullptr;		// so handing the whole list back does not walk it
+		Slot* run_last = nullptr;		// the oldest slot freed since the last allocation
+		std::size_t run = 0;			// how many slots on top of free that is
+		Slot* fresh = nullptr;			// the untouched end of the chunk allocate_fresh() last opened
+		std::size_t fresh_left = 0;
+		bool flushed = false;
+	};
+
+	// Hands the free list of an exiting thread back to the shared pool
+	struct CacheFlusher {
+		~CacheFlusher();
+	};
+
+	static Shared& shared() {
+		static Shared* pool = new Shared;		// never destroyed, lists with static storage may outlive it
+		return *pool;
+	}
+
+	static Cache& cache() {
+		thread_local Cache local;
+		thread_local CacheFlusher flusher;
+		(void)flusher;
+		return local;
+	}
+
+	static Slot* new_chunk();
+	static void refill(Cache& local);
+	static void give_back(Slot* first, Slot* last) noexcept;
+	static void push_local(Cache& local, Slot* first, Slot* last, std::size_t count) noexcept;
+
+public:
+	static void* allocate();
+	static void* allocate_fresh();
+	static void deallocate(void* p) noexcept;
+
+	// Runs of frees at least this long are given to the shared pool instead of the local list
+	static constexpr std::size_t shared_run = NodesPerChunk;
+
+	template <class U, class NextOf>
+	static void deallocate_chain(U* first, NextOf next_of) noexcept;
+};
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+NodePool<Size, Align, NodesPerChunk>::CacheFlusher::~CacheFlusher() {
+	Cache& local = cache();
+	local.flushed = true;
+	if (local.fresh_left) {
+		for (std::size_t i = 0; i + 1 < local.fresh_left; ++i) {
+			local.fresh[i].next = &local.fresh[i + 1];
+		}
+		give_back(local.fresh, &local.fresh[local.fresh_left - 1]);
+		local.fresh_left = 0;
+	}
+	if (!local.free) return;
+
+	give_back(local.free, local.free_last);
+	local.free = nullptr;
+}
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+typename NodePool<Size, Align, NodesPerChunk>::Slot* NodePool<Size, Align, NodesPerChunk>::new_chunk() {
+	Shared& pool = shared();
+	std::lock_guard<std::mutex> lock{ pool.mutex };
+
+	// Room for the pointer first, so push_back can't throw with the chunk in hand
+	if (pool.chunks.size() == pool.chunks.capacity()) pool.chunks.reserve(2 * pool.chunks.capacity() + 1);
+	Slot* chunk = static_cast<Slot*>(::operator new(sizeof(Slot) * NodesPerChunk, std::align_val_t{ alignof(Slot) }));
+	pool.chunks.push_back(chunk);
+	return chunk;
+}
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+void NodePool<Size, Align, NodesPerChunk>::refill(Cache& local) {
+	{
+		Shared& pool = shared();
+		std::lock_guard<std::mutex> lock{ pool.mutex };
+		if (pool.spare) {
+			local.free = pool.spare;
+			local.free_last = pool.spare_last;
+			pool.spare = nullptr;
+			return;
+		}
+	}
+
+	Slot* chunk = new_chunk();
+	for (std::size_t i = 0; i + 1 < NodesPerChunk; ++i) {
+		chunk[i].next = &chunk[i + 1];
+	}
+	chunk[NodesPerChunk - 1].next = nullptr;
+	local.free = chunk;
+	local.free_last = &chunk[NodesPerChunk - 1];
+}
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+void NodePool<Size, Align, NodesPerChunk>::give_back(Slot* first, Slot* last) noexcept {
+	Shared& pool = shared();
+	std::lock_guard<std::mutex> lock{ pool.mutex };
+	last->next = pool.spare;
+	if (!pool.spare) pool.spare_last = last;
+	pool.spare = first;
+}
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+void* NodePool<Size, Align, NodesPerChunk>::allocate() {
+	Cache& local = cache();
+	local.run = 0;
+	if (!local.free) {
+		if (local.fresh_left) {		// what allocate_fresh() left over goes before a new chunk
+			--local.fresh_left;
+			return local.fresh++;
+		}
+		refill(local);
+	}
+
+	Slot* slot = local.free;
+	local.free = slot->next;
+	return slot;
+}
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+void* NodePool<Size, Align, NodesPerChunk>::allocate_fresh() {
+	Cache& local = cache();
+	local.run = 0;
+	if (!local.fresh_left) {
+		local.fresh = new_chunk();
+		local.fresh_left = NodesPerChunk;
+	}
+	--local.fresh_left;
+	return local.fresh++;
+}
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+void NodePool<Size, Align, NodesPerChunk>::deallocate(void* p) noexcept {
+	Slot* slot = static_cast<Slot*>(p);
+	Cache& local = cache();
+
+	if (local.flushed) {		// thread is shutting down, nobody will reuse the local list
+		give_back(slot, slot);
+		return;
+	}
+	push_local(local, slot, slot, 1);
+}
+
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+void NodePool<Size, Align, NodesPerChunk>::push_local(Cache& local, Slot* first, Slot* last, std::size_t count) noexcept {
+	if (local.run == 0) local.run_last = last;
+	if (!local.free) local.free_last = last;
+	last->next = local.free;
+	local.free = first;
+
+	// Nothing was allocated since run_last went in, so the run is the top of the list
+	local.run += count;
+	if (local.run >= shared_run) {
+		Slot* run_first = local.free;
+		local.free = local.run_last->next;
+		give_back(run_first, local.run_last);
+		local.run = 0;
+	}
+}
+
+// next_of is called on every object before its storage is reused and returns
+// the object after it, or null at the end of the chain
+template <std::size_t Size, std::size_t Align, std::size_t NodesPerChunk>
+template <class U, class NextOf>
+void NodePool<Size, Align, NodesPerChunk>::deallocate_chain(U* first, NextOf next_of) noexcept {
+	if (!first) return;
+
+	Slot* freed = nullptr;
+	Slot* last = static_cast<Slot*>(static_cast<void*>(first));
+	std::size_t count = 0;
+	for (U* current = first; current != nullptr; ++count) {
+		U* next = next_of(current);
+		Slot* slot = static_cast<Slot*>(static_cast<void*>(current));
+		slot->next = freed;
+		freed = slot;
+		current = next;
+	}
+
+	Cache& local = cache();
+	if (local.flushed || count >= shared_run) {
+		give_back(freed, last);
+		return;
+	}
+	push_local(local, freed, last, count);
+}
+
+
+template <class Allocator, class = void>
+struct has_allocate_fresh : std::false_type {};
+
+template <class Allocator>
+struct has_allocate_fresh<Allocator, std::void_t<decltype(std::declval<Allocator&>().allocate_fresh())>> : std::true_type {};
+
+template <class Allocator, class = void>
+struct has_deallocate_chain : std::false_type {};
+
+template <class Allocator>
+struct has_deallocate_chain<Allocator, std::void_t<decltype(std::declval<Allocator&>().deallocate_chain(
+	std::declval<typename Allocator::value_type*>(),
+	std::declval<typename Allocator::value_type* (*)(typename Allocator::value_type*)>()))>> : std::true_type {};
+
+} // namespace detail
+
+
+template <class T, std::size_t NodesPerChunk = 1024>
+class PoolAllocator {
+	static_assert(NodesPerChunk > 0, "a chunk has to hold at least one node");
+
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	template <class U>
+	struct rebind { using other = PoolAllocator<U, NodesPerChunk>; };
+
+	PoolAllocator() noexcept = default;
+	template <class U>
+	PoolAllocator(const PoolAllocator<U, NodesPerChunk>&) noexcept {}
+
+	T* allocate(std::size_t n);
+	void deallocate(T* p, std::size_t n) noexcept;
+
+	// Consecutive calls return objects that follow each other in memory, see NodePool. Free them with deallocate(p, 1)
+	T* allocate_fresh() {
+		return static_cast<T*>(detail::NodePool<sizeof(T), alignof(T), NodesPerChunk>::allocate_fresh());
+	}
+
+	// Frees a linked chain of single objects starting at first, see NodePool
+	template <class NextOf>
+	void deallocate_chain(T* first, NextOf next_of) noexcept {
+		detail::NodePool<sizeof(T), alignof(T), NodesPerChunk>::deallocate_chain(first, next_of);
+	}
+};
+
+// Only single objects come from the pool, anything else goes straight to operator new
+template <class T, std::size_t NodesPerChunk>
+T* PoolAllocator<T, NodesPerChunk>::allocate(std::size_t n) {
+	using pool = detail::NodePool<sizeof(T), alignof(T), NodesPerChunk>;
+	if (n == 1) return static_cast<T*>(pool::allocate());
+	if (n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length{};
+	return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+}
+
+template <class T, std::size_t NodesPerChunk>
+void PoolAllocator<T, NodesPerChunk>::deallocate(T* p, std::size_t n) noexcept {
+	using pool = detail::NodePool<sizeof(T), alignof(T), NodesPerChunk>;
+	if (n == 1) pool::deallocate(p);
+	else ::operator delete(p, std::align_val_t{ alignof(T) });
+}
+
+template <class T, class U, std::size_t NodesPerChunk>
+bool operator==(const PoolAllocator<T, NodesPerChunk>&, const PoolAllocator<U, NodesPerChunk>&) noexcept {
+	return true;
+}
+
+template <class T, class U, std::size_t NodesPerChunk>
+bool operator!=(const PoolAllocator<T, NodesPerChunk>&, const PoolAllocator<U, NodesPerChunk>&) noexcept {
+	return false;
+}
+
+#endif
@@ -0,0 +1,211 @@
+//
+//  SimdSearch.h
+//  Data Structure - LinkedList
+//
+// Vectorized find/count over contiguous blocks of 32 and 64 bit arithmetic
+// values. On x86 the AVX2 kernels are picked at run time when the CPU has
+// them, SSE2 otherwise; every other target and element type falls back to
+// the scalar std algorithms.
+//
+// Matches use ==, so a NaN is never found and -0.0 finds +0.0.
+//
+
+#ifndef SIMDSEARCH_h
+#define SIMDSEARCH_h
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#define SIMDSEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+
+namespace simd {
+
+template <class T>
+constexpr bool is_vectorizable = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+	&& (sizeof(T) == 4 || sizeof(T) == 8);
+
+namespace detail {
+
+#ifdef SIMDSEARCH_X86
+
+inline bool has_avx2() noexcept {
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	return avx2;
+}
+
+// The needle is read with memcpy, an unsigned or a long only matches the lane type in size
+template <class Lane>
+inline Lane lane_value(const void* value) noexcept {
+	Lane lane;
+	std::memcpy(&lane, value, sizeof lane);
+	return lane;
+}
+
+// Every Lanes type compares `width` values at once and returns one mask bit per value
+
+struct Sse2Int32 {
+	static constexpr std::size_t width = 4;
+	using vector = __m128i;
+	static vector broadcast(const void* value) { return _mm_set1_epi32(lane_value<std::int32_t>(value)); }
+	static vector load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+	static unsigned match(vector a, vector b) { return unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+};
+
+struct Sse2Int64 {
+	static constexpr std::size_t width = 2;
+	using vector = __m128i;
+	static vector broadcast(const void* value) { return _mm_set1_epi64x(lane_value<std::int64_t>(value)); }
+	static vector load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+	static unsigned match(vector a, vector b) {
+		// SSE2 has no 64 bit compare, both 32 bit halves have to match
+		__m128i halves = _mm_cmpeq_epi32(a, b);
+		__m128i both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+		return unsigned(_mm_movemask_pd(_mm_castsi128_pd(both)));
+	}
+};
+
+struct Sse2Float {
+	static constexpr std::size_t width = 4;
+	using vector = __m128;
+	static vector broadcast(const void* value) { return _mm_set1_ps(*static_cast<const float*>(value)); }
+	static vector load(const void* p) { return _mm_loadu_ps(static_cast<const float*>(p)); }
+	static unsigned match(vector a, vector b) { return unsigned(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+};
+
+struct Sse2Double {
+	static constexpr std::size_t width = 2;
+	using vector = __m128d;
+	static vector broadcast(const void* value) { return _mm_set1_pd(*static_cast<const double*>(value)); }
+	static vector load(const void* p) { return _mm_loadu_pd(static_cast<const double*>(p)); }
+	static unsigned match(vector a, vector b) { return unsigned(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+};
+
+template <class Lanes, class T>
+inline const T* find_sse2(const T* first, const T* last, const T& value) {
+	const auto needle = Lanes::broadcast(&value);
+	for (; last - first >= std::ptrdiff_t(Lanes::width); first += Lanes::width) {
+		if (unsigned mask = Lanes::match(Lanes::load(first), needle)) return first + __builtin_ctz(mask);
+	}
+	return std::find(first, last, value);
+}
+
+template <class Lanes, class T>
+inline std::size_t count_sse2(const T* first, const T* last, const T& value) {
+	const auto needle = Lanes::broadcast(&value);
+	std::size_t matches = 0;
+	for (; last - first >= std::ptrdiff_t(Lanes::width); first += Lanes::width) {
+		matches += std::size_t(__builtin_popcount(Lanes::match(Lanes::load(first), needle)));
+	}
+	return matches + std::size_t(std::count(first, last, value));
+}
+
+// The AVX2 lanes and kernels are all built for AVX2 and forced inline into each
+// other, 256 bit vectors never cross a call into code built without it
+#define SIMDSEARCH_AVX2 __attribute__((target("avx2"), always_inline)) inline
+
+struct Avx2Int32 {
+	static constexpr std::size_t width = 8;
+	using vector = __m256i;
+	SIMDSEARCH_AVX2 static vector broadcast(const void* value) { return _mm256_set1_epi32(lane_value<std::int32_t>(value)); }
+	SIMDSEARCH_AVX2 static vector load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+	SIMDSEARCH_AVX2 static unsigned match(vector a, vector b) { return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+};
+
+struct Avx2Int64 {
+	static constexpr std::size_t width = 4;
+	using vector = __m256i;
+	SIMDSEARCH_AVX2 static vector broadcast(const void* value) { return _mm256_set1_epi64x(lane_value<std::int64_t>(value)); }
+	SIMDSEARCH_AVX2 static vector load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+	SIMDSEARCH_AVX2 static unsigned match(vector a, vector b) { return unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))); }
+};
+
+struct Avx2Float {
+	static constexpr std::size_t width = 8;
+	using vector = __m256;
+	SIMDSEARCH_AVX2 static vector broadcast(const void* value) { return _mm256_set1_ps(*static_cast<const float*>(value)); }
+	SIMDSEARCH_AVX2 static vector load(const void* p) { return _mm256_loadu_ps(static_cast<const float*>(p)); }
+	SIMDSEARCH_AVX2 static unsigned match(vector a, vector b) { return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+};
+
+struct Avx2Double {
+	static constexpr std::size_t width = 4;
+	using vector = __m256d;
+	SIMDSEARCH_AVX2 static vector broadcast(const void* value) { return _mm256_set1_pd(*static_cast<const double*>(value)); }
+	SIMDSEARCH_AVX2 static vector load(const void* p) { return _mm256_loadu_pd(static_cast<const double*>(p)); }
+	SIMDSEARCH_AVX2 static unsigned match(vector a, vector b) { return unsigned(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+};
+
+#undef SIMDSEARCH_AVX2
+
+template <class Lanes, class T>
+__attribute__((target("avx2"))) const T* find_avx2(const T* first, const T* last, const T& value) {
+	const auto needle = Lanes::broadcast(&value);
+	for (; last - first >= std::ptrdiff_t(Lanes::width); first += Lanes::width) {
+		if (unsigned mask = Lanes::match(Lanes::load(first), needle)) return first + __builtin_ctz(mask);
+	}
+	return std::find(first, last, value);
+}
+
+template <class Lanes, class T>
+__attribute__((target("avx2"))) std::size_t count_avx2(const T* first, const T* last, const T& value) {
+	const auto needle = Lanes::broadcast(&value);
+	std::size_t matches = 0;
+	for (; last - first >= std::ptrdiff_t(Lanes::width); first += Lanes::width) {
+		matches += std::size_t(__builtin_popcount(Lanes::match(Lanes::load(first), needle)));
+	}
+	return matches + std::size_t(std::count(first, last, value));
+}
+
+template <class T>
+struct LanesFor {
+	using sse2 = std::conditional_t<std::is_floating_point<T>::value,
+		std::conditional_t<sizeof(T) == 4, Sse2Float, Sse2Double>,
+		std::conditional_t<sizeof(T) == 4, Sse2Int32, Sse2Int64>>;
+	using avx2 = std::conditional_t<std::is_floating_point<T>::value,
+		std::conditional_t<sizeof(T) == 4, Avx2Float, Avx2Double>,
+		std::conditional_t<sizeof(T) == 4, Avx2Int32, Avx2Int64>>;
+};
+
+#endif // SIMDSEARCH_X86
+
+} // namespace detail
+
+
+// Pointer to the first element equal to value, or last
+template <class T>
+const T* find(const T* first, const T* last, const T& value) {
+#ifdef SIMDSEARCH_X86
+	if constexpr (is_vectorizable<T>) {
+		using lanes = detail::LanesFor<T>;
+		if (detail::has_avx2()) return detail::find_avx2<typename lanes::avx2>(first, last, value);
+		return detail::find_sse2<typename lanes::sse2>(first, last, value);
+	}
+#endif
+	return std::find(first, last, value);
+}
+
+template <class T>
+std::size_t count(const T* first, const T* last, const T& value) {
+#ifdef SIMDSEARCH_X86
+	if constexpr (is_vectorizable<T>) {
+		using lanes = detail::LanesFor<T>;
+		if (detail::has_avx2()) return detail::count_avx2<typename lanes::avx2>(first, last, value);
+		return detail::count_sse2<typename lanes::sse2>(first, last, value);
+	}
+#endif
+	return std::size_t(std::count(first, last, value));
+}
+
+// True if any of [keys_first, keys_last) occurs in [first, last)
+template <class T>
+bool contains_any(const T* first, const T* last, const T* keys_first, const T* keys_last) {
+	for (; keys_first != keys_last; ++keys_first) {
+		if (simd::find(first, last, *keys_first) != last) return true;
+	}
+	return false;
+}
+
+} // namespace simd
+
+#endif
@@ -1,472 +1,1180 @@
-//
-//  SingleLinkedList.h
-//  Data Structure - LinkedList
-//
-//  Created by Morgan Weiss on 7/24/2018
-//  Copyright  2018 Morgan Weiss. All rights reserved.
-//
-
-#ifndef SINGLELINKEDLIST_h
-#define SINGLELINKEDLIST_h
-
-
-
-template <class T>
-class SingleLinkedList {
-private:
-
-	struct Node {
-		T data;
-		std::unique_ptr<Node> next = nullptr;
-
-		template<typename... Args, typename = std::enable_if_t<std::is_constructible<T, Args&&...>::value>>
-		explicit Node(std::unique_ptr<Node>&& next, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value)
-			: data{ std::forward<Args>(args)... }, next{ std::move(next) } {}
-
-		// disable if noncopyable<T> for cleaner error msgs
-		explicit Node(const T& x, std::unique_ptr<Node>&& p = nullptr)
-			: data(x)
-			, next(std::move(p)) {}
-
-		// disable if nonmovable<T> for cleaner error msgs
-		explicit Node(T&& x, std::unique_ptr<Node>&& p = nullptr)
-			: data(std::move(x))
-			, next(std::move(p)) {}
-	};
-	std::unique_ptr<Node> head = nullptr;
-	Node* tail = nullptr;
-
-	void do_pop_front() {
-		head = std::move(head->next);
-		if (!tail) tail = head.get(); // update tail if list was empty before
-	}
-
-
-public:
-	// Constructors
-	SingleLinkedList() = default;                                           // empty constructor 
-	SingleLinkedList(SingleLinkedList const &source);                       // copy constructor
-
-																			// Rule of 5
-	SingleLinkedList(SingleLinkedList &&move) noexcept;                     // move constructor
-	SingleLinkedList& operator=(SingleLinkedList &&move) noexcept;          // move assignment operator
-	~SingleLinkedList() noexcept;
-
-	// Overload operators
-	SingleLinkedList& operator=(SingleLinkedList const &rhs);
-
-	// Create an iterator class
-	class iterator;
-	iterator begin();
-	iterator end();
-	iterator before_begin();
-
-	// Create const iterator class
-	class const_iterator;
-	const_iterator cbegin() const;
-	const_iterator cend() const;
-	const_iterator begin() const;
-	const_iterator end() const;
-	const_iterator before_begin() const;
-	const_iterator cbefore_begin() const;
-
-	// Memeber functions
-	void swap(SingleLinkedList &other) noexcept;
-	bool empty() const { return head.get() == nullptr; }
-	int size() const;
-
-	template<typename... Args>
-	void emplace_back(Args&&... args);
-
-	template<typename... Args>
-	void emplace_front(Args&&... args);
-
-	template<typename... Args>
-	iterator emplace(const_iterator pos, Args&&... args);
-
-	void push_back(const T &theData);
-	void push_back(T &&theData);
-	void push_front(const T &theData);
-	void push_front(T &&theData);
-	iterator insert_after(const_iterator pos, const T& theData);
-	iterator insert_after(const_iterator pos, T&& theData);
-	void clear();
-	void pop_front();
-	void pop_back();
-	iterator erase_after(const_iterator pos);
-	bool search(const T &x);
-
-
-
-};
-
-template <class T>
-class SingleLinkedList<T>::iterator {
-	Node* node = nullptr;
-	bool before_begin = false;
-
-public:
-	friend class SingleLinkedList<T>;
-
-	using iterator_category = std::forward_iterator_tag;
-	using value_type = T;
-	using difference_type = std::ptrdiff_t;
-	using pointer = T * ;
-	using reference = T & ;
-
-	iterator(Node* node = nullptr, bool before = false) : node{ node }, before_begin{ before } {}
-
-	operator const_iterator() const noexcept { return const_iterator{ node, before_begin }; }
-	bool operator!=(iterator other) const noexcept;
-	bool operator==(iterator other) const noexcept;
-
-	T& operator*() const { return node->data; }
-	T* operator->() const { return &node->data; }
-
-	iterator& operator++();
-	iterator operator++(int);
-};
-
-template <class T>
-class SingleLinkedList<T>::const_iterator {
-	Node* node = nullptr;
-	bool before_begin = false;
-
-public:
-	friend class SingleLinkedList<T>;
-
-	using iterator_category = std::forward_iterator_tag;
-	using value_type = T;
-	using difference_type = std::ptrdiff_t;
-	using pointer = const T * ;
-	using reference = const T & ;
-
-	const_iterator() = default;
-	const_iterator(Node* node, bool before = false) : node{ node }, before_begin{ before } {}
-
-	
-	bool operator!=(const_iterator other) const noexcept;
-	bool operator==(const_iterator other) const noexcept;
-
-	const T& operator*() const { return node->data; }
-	const T* operator->() const { return &node->data; }
-
-	const_iterator& operator++();
-	const_iterator operator++(int);
-};
-
-
-template <class T>
-SingleLinkedList<T>::SingleLinkedList(SingleLinkedList<T> const &source) {
-	for (Node* loop = source.head.get(); loop != nullptr; loop = loop->next.get()) {
-		emplace_back(loop->data);
-	}
-}
-
-template <class T>
-SingleLinkedList<T>::SingleLinkedList(SingleLinkedList<T>&& move) noexcept {
-	move.swap(*this);
-}
-
-template <class T>
-SingleLinkedList<T>& SingleLinkedList<T>::operator=(SingleLinkedList<T> &&move) noexcept {
-	move.swap(*this);
-	return *this;
-}
-
-template <class T>
-SingleLinkedList<T>::~SingleLinkedList() noexcept {
-	clear();
-}
-
-template <class T>
-void SingleLinkedList<T>::clear() {
-	while (head) {
-		do_pop_front();
-	}
-}
-
-template <class T>
-SingleLinkedList<T>& SingleLinkedList<T>::operator=(SingleLinkedList const &rhs) {
-	SingleLinkedList copy{ rhs };
-	swap(copy);
-	return *this;
-}
-
-template <class T>
-void SingleLinkedList<T>::swap(SingleLinkedList &other) noexcept {
-	using std::swap;
-	swap(head, other.head);
-	swap(tail, other.tail);
-}
-
-template <class T>
-int SingleLinkedList<T>::size() const {
-	int size = 0;
-	for (auto current = head.get(); current != nullptr; current = current->next.get()) {
-		size++;
-	}
-	return size;
-}
-
-
-template <class T>
-template <typename... Args>
-void SingleLinkedList<T>::emplace_back(Args&&... args) {
-	std::unique_ptr<Node> newnode = std::make_unique<Node>(std::forward<Args>(args)...);
-
-	if (!head) {
-		head = std::move(newnode);
-		tail = head.get();
-	}
-
-	else {
-		tail->next = std::move(newnode);
-		tail = tail->next.get();
-	}
-}
-
-template <class T>
-template <typename... Args>
-typename SingleLinkedList<T>::iterator SingleLinkedList<T>::emplace(const_iterator pos, Args&&... args) {
-	if (pos.before_begin) {
-		emplace_front(std::forward<Args>(args)...);
-		return begin();
-	}
-
-	if (pos.node) {
-		pos.node->next = std::make_unique<Node>(std::move(pos.node->next), std::forward<Args>(args)...);  // Creating a new node that has the old next pointer with the new value and assign it to the next pointer of the current node 
-		if (pos.node == tail) tail = tail->next.get();
-		return { pos.node->next.get() };
-	}
-	throw std::out_of_range{ "end iterator got passed to insert!" };
-}
-
-template <class T>
-void SingleLinkedList<T>::push_back(const T &theData) {
-	std::unique_ptr<Node> newNode = std::make_unique<Node>(theData);
-
-	if (!head) {
-		head = std::move(newNode);
-		tail = head.get();
-	}
-	else {
-		tail->next = std::move(newNode);
-		tail = tail->next.get();
-	}
-}
-
-template <class T>
-void SingleLinkedList<T>::push_back(T &&theData) {
-	std::unique_ptr<Node> newNode = std::make_unique<Node>(std::move(theData));
-
-	if (!head) {
-		head = std::move(newNode);
-		tail = head.get();
-	}
-	else {
-		tail->next = std::move(newNode);
-		tail = tail->next.get();
-	}
-}
-
-
-template <class T>
-template <typename... Args>
-void SingleLinkedList<T>::emplace_front(Args&&... args) {
-	head = std::make_unique<Node>(std::move(head), std::forward<Args>(args)...);
-	if (!tail) tail = head.get(); // update tail if list was empty before
-}
-
-
-template <class T>
-void SingleLinkedList<T>::push_front(const T &theData) {
-	std::unique_ptr<Node> newNode = std::make_unique<Node>(theData);
-	newNode->next = std::move(head);
-	head = std::move(newNode);
-
-	if (!tail) {
-		tail = head.get();
-	}
-}
-
-template <class T>
-void SingleLinkedList<T>::push_front(T &&theData) {
-	std::unique_ptr<Node> newNode = std::make_unique<Node>(std::move(theData));
-	newNode->next = std::move(head);
-	head = std::move(newNode);
-
-	if (!tail) {
-		tail = head.get();
-	}
-}
-
-template <class T>
-typename SingleLinkedList<T>::iterator SingleLinkedList<T>::insert_after(const_iterator pos, const T& theData) {
-	return emplace(pos, theData);
-}
-
-template <class T>
-typename  SingleLinkedList<T>::iterator SingleLinkedList<T>::insert_after(const_iterator pos, T&& theData)
-{
-	return emplace(pos, std::move(theData));
-}
-
-template <class T>
-void SingleLinkedList<T>::pop_front() {
-	if (empty()) {
-		return;
-	}
-	do_pop_front();
-}
-
-template <class T>
-void SingleLinkedList<T>::pop_back() {
-	if (!head) return;
-
-	auto current = head.get();
-	Node* previous = nullptr;
-
-	while (current->next) {
-		previous = current;
-		current = current->next.get();
-	}
-	if (previous) {
-		previous->next = nullptr;
-	}
-	else {
-		head = nullptr;
-	}
-	tail = previous;
-	previous->next = nullptr;
-}
-
-template <class T>
-typename SingleLinkedList<T>::iterator SingleLinkedList<T>::erase_after(const_iterator pos) {
-	if (pos.before_begin) {
-		pop_front();
-		return begin();
-	}
-
-	if (pos.node && pos.node->next) {
-		pos.node->next = std::move(pos.node->next->next);
-		return { pos.node->next.get() };
-	}
-
-	return end();
-}
-
-template <class T>
-bool SingleLinkedList<T>::search(const T &x) {
-	return std::find(begin(), end(), x) != end();
-}
-
-template <class T>
-std::ostream& operator<<(std::ostream &str, SingleLinkedList<T>& list) {
-	for (auto const& item : list) {
-		str << item << "\t";
-	}
-	return str;
-}
-
-// Iterator Implementaion////////////////////////////////////////////////
-template <class T>
-typename SingleLinkedList<T>::iterator& SingleLinkedList<T>::iterator::operator++() {
-	if (before_begin) before_begin = false;
-	else node = node->next.get();
-
-	return *this;
-}
-
-template<typename T>
-typename SingleLinkedList<T>::iterator SingleLinkedList<T>::iterator::operator++(int) {
-	auto copy = *this;
-	++*this;
-	return copy;
-}
-
-template<typename T>
-bool SingleLinkedList<T>::iterator::operator==(iterator other) const noexcept {
-	return node == other.node && before_begin == other.before_begin;
-}
-
-template<typename T>
-bool SingleLinkedList<T>::iterator::operator!=(iterator other) const noexcept {
-	return !(*this == other);
-}
-
-
-
-template<class T>
-typename SingleLinkedList<T>::iterator SingleLinkedList<T>::begin() {
-	return head.get();
-}
-
-template<class T>
-typename SingleLinkedList<T>::iterator SingleLinkedList<T>::end() {
-	return {};
-}
-
-template <class T>
-typename SingleLinkedList<T>::iterator SingleLinkedList<T>::before_begin() {
-	return { head.get(), true };
-}
-
-// Const Iterator Implementaion////////////////////////////////////////////////
-template <class T>
-typename SingleLinkedList<T>::const_iterator& SingleLinkedList<T>::const_iterator::operator++() {
-	if (before_begin) before_begin = false;
-	else node = node->next.get();
-
-	return *this;
-}
-
-template<typename T>
-typename SingleLinkedList<T>::const_iterator SingleLinkedList<T>::const_iterator::operator++(int) {
-	auto copy = *this;
-	++*this;
-	return copy;
-}
-
-template<typename T>
-bool SingleLinkedList<T>::const_iterator::operator==(const_iterator other) const noexcept {
-	return node == other.node && before_begin == other.before_begin;
-}
-
-template<typename T>
-bool SingleLinkedList<T>::const_iterator::operator!=(const_iterator other) const noexcept {
-	return !(*this == other);
-}
-
-
-template <class T>
-typename SingleLinkedList<T>::const_iterator SingleLinkedList<T>::begin() const {
-	return head.get();
-}
-
-template <class T>
-typename SingleLinkedList<T>::const_iterator SingleLinkedList<T>::end() const {
-	return {};
-}
-
-template <class T>
-typename SingleLinkedList<T>::const_iterator SingleLinkedList<T>::cbegin() const {
-	return begin();
-}
-
-template <class T>
-typename SingleLinkedList<T>::const_iterator SingleLinkedList<T>::cend() const {
-	return end();
-}
-
-template <class T>
-typename SingleLinkedList<T>::const_iterator SingleLinkedList<T>::before_begin() const {
-	return { head.get(), true };
-}
-
-template <class T>
-typename SingleLinkedList<T>::const_iterator SingleLinkedList<T>::cbefore_begin() const {
-	return before_begin();
-}
-
+//
+//  SingleLinkedList.h
+//  Data Structure - LinkedList
+//
+//  Created by Morgan Weiss on 7/24/2018
+//  Copyright  2018 Morgan Weiss. All rights reserved.
+//
+
+#ifndef SINGLELINKEDLIST_h
+#define SINGLELINKEDLIST_h
+
+#include "SimdSearch.h"
+#include "Prefetch.h"
+#include "KeySet.h"
+#include "PoolAllocator.h"
+#include "BackgroundReclaimer.h"
+
+
+// BackLinks keeps a pointer to the previous node in every node so that
+// pop_back is O(1). Leave it off if you never remove from the back.
+template <class T, class Allocator = std::allocator<T>, bool BackLinks = false>
+class SingleLinkedList {
+private:
+
+	struct Node;
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
+	// Each link hands its node back to the allocator it came from
+	struct NodeDeleter : node_allocator {
+		NodeDeleter() = default;
+		NodeDeleter(const node_allocator& alloc) : node_allocator(alloc) {}
+
+		void operator()(Node* node) noexcept {
+			node_traits::destroy(*this, node);
+			node_traits::deallocate(*this, node, 1);
+		}
+	};
+	using node_ptr = std::unique_ptr<Node, NodeDeleter>;
+
+	struct NoBackLink {};
+	struct BackLink {
+		Node* previous = nullptr;
+	};
+
+	struct Node : std::conditional_t<BackLinks, BackLink, NoBackLink> {
+		T data;
+		node_ptr next = nullptr;
+
+		template<typename... Args, typename = std::enable_if_t<std::is_constructible<T, Args&&...>::value>>
+		explicit Node(node_ptr&& next, Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value)
+			: data{ std::forward<Args>(args)... }, next{ std::move(next) } {}
+
+		// disable if noncopyable<T> for cleaner error msgs
+		explicit Node(const T& x, node_ptr&& p = nullptr)
+			: data(x)
+			, next(std::move(p)) {}
+
+		// disable if nonmovable<T> for cleaner error msgs
+		explicit Node(T&& x, node_ptr&& p = nullptr)
+			: data(std::move(x))
+			, next(std::move(p)) {}
+	};
+	node_ptr head = nullptr;
+	Node* tail = nullptr;
+	std::size_t length = 0;
+	node_allocator alloc;
+
+	template <typename InputIt>
+	using RequireInputIterator = std::enable_if_t<std::is_convertible<
+		typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>::value>;
+
+	template <typename... Args>
+	node_ptr make_node(Args&&... args);
+
+	std::size_t count_nodes() const;
+
+	static Node* next_of(const Node* node) noexcept { return node->next.get(); }
+
+	template <typename Compare>
+	static void merge_chains(node_ptr &first, node_ptr &second, Compare &comp);
+	static void append_chain(node_ptr &chain, node_ptr &&rest) noexcept;
+	void restore_links() noexcept;
+
+	template <typename InputIt>
+	node_ptr build_chain(InputIt first, InputIt last, Node* &chain_tail, std::size_t &built);
+	static void free_chain(node_ptr chain) noexcept;
+	void truncate(Node* last_kept, std::size_t kept) noexcept;
+	Node* allocate_fresh_node();
+
+	static void link_back(Node* node, Node* previous) noexcept {
+		if constexpr (BackLinks) {
+			if (node) node->previous = previous;
+		}
+	}
+
+	void do_pop_front() {
+		head = std::move(head->next);
+		if (!head) tail = nullptr; // list became empty
+		link_back(head.get(), nullptr);
+		--length;
+	}
+
+
+public:
+	// Constructors
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	SingleLinkedList() = default;                                           // empty constructor 
+	explicit SingleLinkedList(const Allocator &alloc);                     // empty constructor with allocator
+	SingleLinkedList(SingleLinkedList const &source);                       // copy constructor
+	SingleLinkedList(size_type count, const T &value, const Allocator &alloc = Allocator());
+	SingleLinkedList(std::initializer_list<T> init, const Allocator &alloc = Allocator());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	SingleLinkedList(InputIt first, InputIt last, const Allocator &alloc = Allocator());
+
+																			// Rule of 5
+	SingleLinkedList(SingleLinkedList &&move) noexcept;                     // move constructor
+	SingleLinkedList& operator=(SingleLinkedList &&move) noexcept;          // move assignment operator
+	~SingleLinkedList() noexcept;
+
+	// Overload operators
+	SingleLinkedList& operator=(SingleLinkedList const &rhs);
+	SingleLinkedList& operator=(std::initializer_list<T> init);
+
+	// Create an iterator class
+	class iterator;
+	iterator begin();
+	iterator end();
+	iterator before_begin();
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator cbegin() const;
+	const_iterator cend() const;
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_iterator before_begin() const;
+	const_iterator cbefore_begin() const;
+
+	// Memeber functions
+	void swap(SingleLinkedList &other) noexcept;
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+	bool empty() const { return head.get() == nullptr; }
+	size_type size() const noexcept;
+
+	template<typename... Args>
+	void emplace_back(Args&&... args);
+
+	template<typename... Args>
+	void emplace_front(Args&&... args);
+
+	template<typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args);
+
+	void push_back(const T &theData);
+	void push_back(T &&theData);
+	void push_front(const T &theData);
+	void push_front(T &&theData);
+	iterator insert_after(const_iterator pos, const T& theData);
+	iterator insert_after(const_iterator pos, T&& theData);
+	void clear();
+	void clear_async();
+	void pop_front();
+	void pop_back();
+	iterator erase_after(const_iterator pos);
+	bool search(const T &x);
+	size_type count(const T &x) const;
+
+	template<typename Predicate>
+	iterator find_if(Predicate pred);
+
+	template<std::size_t Distance = detail::prefetch_distance, typename Function>
+	void for_each(Function f);
+
+	template<std::size_t Distance = detail::prefetch_distance, typename Function>
+	void for_each(Function f) const;
+
+	template<typename InputIt>
+	bool contains_any(InputIt first, InputIt last) const;
+
+	template<typename InputIt>
+	std::vector<bool> search_many(InputIt first, InputIt last) const;
+
+	template<typename Predicate>
+	std::vector<iterator> find_all(Predicate pred);
+
+	template<typename Compare = std::less<T>>
+	void sort(Compare comp = Compare());
+
+	template<typename Compare = std::less<T>>
+	void merge(SingleLinkedList &other, Compare comp = Compare());
+
+	template<typename Compare = std::less<T>>
+	void merge(SingleLinkedList &&other, Compare comp = Compare());
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	void assign(InputIt first, InputIt last);
+	void assign(size_type count, const T &value);
+	void assign(std::initializer_list<T> init);
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	iterator insert_range_after(const_iterator pos, InputIt first, InputIt last);
+
+	template<typename InputIt, typename = RequireInputIterator<InputIt>>
+	void append_range(InputIt first, InputIt last);
+
+	void splice_after(const_iterator pos, SingleLinkedList &other) noexcept;
+	void splice_after(const_iterator pos, SingleLinkedList &&other) noexcept;
+	void splice_after(const_iterator pos, SingleLinkedList &other, const_iterator it) noexcept;
+	void splice_after(const_iterator pos, SingleLinkedList &&other, const_iterator it) noexcept;
+	void splice_after(const_iterator pos, SingleLinkedList &other, const_iterator first, const_iterator last) noexcept;
+	void splice_after(const_iterator pos, SingleLinkedList &&other, const_iterator first, const_iterator last) noexcept;
+
+	void relayout();
+	iterator relayout_after(const_iterator pos, size_type max_nodes);
+	double scattered_link_fraction() const noexcept;
+
+private:
+	node_ptr detach(node_ptr &from, Node* owner, Node* last) noexcept;
+	void attach(const_iterator pos, node_ptr chain, Node* last) noexcept;
+
+
+
+};
+
+template <class T, class Allocator, bool BackLinks>
+class SingleLinkedList<T, Allocator, BackLinks>::iterator {
+	Node* node = nullptr;
+	bool before_begin = false;
+
+public:
+	friend class SingleLinkedList<T, Allocator, BackLinks>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T * ;
+	using reference = T & ;
+
+	iterator(Node* node = nullptr, bool before = false) : node{ node }, before_begin{ before } {}
+
+	operator const_iterator() const noexcept { return const_iterator{ node, before_begin }; }
+	bool operator!=(iterator other) const noexcept;
+	bool operator==(iterator other) const noexcept;
+
+	T& operator*() const { return node->data; }
+	T* operator->() const { return &node->data; }
+
+	iterator& operator++();
+	iterator operator++(int);
+};
+
+template <class T, class Allocator, bool BackLinks>
+class SingleLinkedList<T, Allocator, BackLinks>::const_iterator {
+	Node* node = nullptr;
+	bool before_begin = false;
+
+public:
+	friend class SingleLinkedList<T, Allocator, BackLinks>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T * ;
+	using reference = const T & ;
+
+	const_iterator() = default;
+	const_iterator(Node* node, bool before = false) : node{ node }, before_begin{ before } {}
+
+	
+	bool operator!=(const_iterator other) const noexcept;
+	bool operator==(const_iterator other) const noexcept;
+
+	const T& operator*() const { return node->data; }
+	const T* operator->() const { return &node->data; }
+
+	const_iterator& operator++();
+	const_iterator operator++(int);
+};
+
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>::SingleLinkedList(const Allocator &alloc) : alloc{ alloc } {}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>::SingleLinkedList(SingleLinkedList<T, Allocator, BackLinks> const &source)
+	: alloc{ node_traits::select_on_container_copy_construction(source.alloc) } {
+	append_range(source.begin(), source.end());
+}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>::SingleLinkedList(size_type count, const T &value, const Allocator &alloc) : alloc{ alloc } {
+	assign(count, value);
+}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>::SingleLinkedList(std::initializer_list<T> init, const Allocator &alloc) : alloc{ alloc } {
+	append_range(init.begin(), init.end());
+}
+
+template <class T, class Allocator, bool BackLinks>
+template <typename InputIt, typename>
+SingleLinkedList<T, Allocator, BackLinks>::SingleLinkedList(InputIt first, InputIt last, const Allocator &alloc) : alloc{ alloc } {
+	append_range(first, last);
+}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>::SingleLinkedList(SingleLinkedList<T, Allocator, BackLinks>&& move) noexcept {
+	move.swap(*this);
+}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>& SingleLinkedList<T, Allocator, BackLinks>::operator=(SingleLinkedList<T, Allocator, BackLinks> &&move) noexcept {
+	move.swap(*this);
+	return *this;
+}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>::~SingleLinkedList() noexcept {
+	clear();
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::clear() {
+	free_chain(std::move(head));
+	tail = nullptr;
+	length = 0;
+}
+
+// Detaches the nodes at once and leaves freeing them to BackgroundReclaimer.
+// Falls back to clear() if the hand-off cannot be queued.
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::clear_async() {
+	if (!head) return;
+
+	node_ptr* chain = new (std::nothrow) node_ptr{ std::move(head) };
+	tail = nullptr;
+	length = 0;
+	if (!chain) {
+		free_chain(std::move(head));
+		return;
+	}
+
+	try {
+		BackgroundReclaimer::post(chain, [](void* p) {
+			node_ptr* detached = static_cast<node_ptr*>(p);
+			free_chain(std::move(*detached));
+			delete detached;
+		});
+	}
+	catch (...) {
+		free_chain(std::move(*chain));
+		delete chain;
+	}
+}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>& SingleLinkedList<T, Allocator, BackLinks>::operator=(SingleLinkedList const &rhs) {
+	SingleLinkedList copy{ rhs };
+	swap(copy);
+	return *this;
+}
+
+template <class T, class Allocator, bool BackLinks>
+SingleLinkedList<T, Allocator, BackLinks>& SingleLinkedList<T, Allocator, BackLinks>::operator=(std::initializer_list<T> init) {
+	assign(init);
+	return *this;
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::swap(SingleLinkedList &other) noexcept {
+	using std::swap;
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(length, other.length);
+	swap(alloc, other.alloc);
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::size_type SingleLinkedList<T, Allocator, BackLinks>::size() const noexcept {
+	assert(length == count_nodes() && "cached size is out of sync with the chain");
+	return length;
+}
+
+template <class T, class Allocator, bool BackLinks>
+std::size_t SingleLinkedList<T, Allocator, BackLinks>::count_nodes() const {
+	std::size_t nodes = 0;
+	detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&nodes](const Node*) { ++nodes; return false; });
+	return nodes;
+}
+
+
+template <class T, class Allocator, bool BackLinks>
+template <typename... Args>
+typename SingleLinkedList<T, Allocator, BackLinks>::node_ptr SingleLinkedList<T, Allocator, BackLinks>::make_node(Args&&... args) {
+	Node* node = node_traits::allocate(alloc, 1);
+	try {
+		node_traits::construct(alloc, node, std::forward<Args>(args)...);
+	}
+	catch (...) {
+		node_traits::deallocate(alloc, node, 1);
+		throw;
+	}
+	return { node, NodeDeleter{ alloc } };
+}
+
+template <class T, class Allocator, bool BackLinks>
+template <typename... Args>
+void SingleLinkedList<T, Allocator, BackLinks>::emplace_back(Args&&... args) {
+	node_ptr newnode = make_node(std::forward<Args>(args)...);
+	link_back(newnode.get(), tail);
+
+	if (!head) {
+		head = std::move(newnode);
+		tail = head.get();
+	}
+
+	else {
+		tail->next = std::move(newnode);
+		tail = tail->next.get();
+	}
+	++length;
+}
+
+template <class T, class Allocator, bool BackLinks>
+template <typename... Args>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::emplace(const_iterator pos, Args&&... args) {
+	if (pos.before_begin) {
+		emplace_front(std::forward<Args>(args)...);
+		return begin();
+	}
+
+	if (pos.node) {
+		pos.node->next = make_node(std::move(pos.node->next), std::forward<Args>(args)...);  // Creating a new node that has the old next pointer with the new value and assign it to the next pointer of the current node 
+		link_back(pos.node->next.get(), pos.node);
+		link_back(pos.node->next->next.get(), pos.node->next.get());
+		if (pos.node == tail) tail = tail->next.get();
+		++length;
+		return { pos.node->next.get() };
+	}
+	throw std::out_of_range{ "end iterator got passed to insert!" };
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::push_back(const T &theData) {
+	node_ptr newNode = make_node(theData);
+	link_back(newNode.get(), tail);
+
+	if (!head) {
+		head = std::move(newNode);
+		tail = head.get();
+	}
+	else {
+		tail->next = std::move(newNode);
+		tail = tail->next.get();
+	}
+	++length;
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::push_back(T &&theData) {
+	node_ptr newNode = make_node(std::move(theData));
+	link_back(newNode.get(), tail);
+
+	if (!head) {
+		head = std::move(newNode);
+		tail = head.get();
+	}
+	else {
+		tail->next = std::move(newNode);
+		tail = tail->next.get();
+	}
+	++length;
+}
+
+
+template <class T, class Allocator, bool BackLinks>
+template <typename... Args>
+void SingleLinkedList<T, Allocator, BackLinks>::emplace_front(Args&&... args) {
+	head = make_node(std::move(head), std::forward<Args>(args)...);
+	link_back(head->next.get(), head.get());
+	if (!tail) tail = head.get(); // update tail if list was empty before
+	++length;
+}
+
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::push_front(const T &theData) {
+	node_ptr newNode = make_node(theData);
+	newNode->next = std::move(head);
+	head = std::move(newNode);
+	link_back(head->next.get(), head.get());
+
+	if (!tail) {
+		tail = head.get();
+	}
+	++length;
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::push_front(T &&theData) {
+	node_ptr newNode = make_node(std::move(theData));
+	newNode->next = std::move(head);
+	head = std::move(newNode);
+	link_back(head->next.get(), head.get());
+
+	if (!tail) {
+		tail = head.get();
+	}
+	++length;
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::insert_after(const_iterator pos, const T& theData) {
+	return emplace(pos, theData);
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename  SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::insert_after(const_iterator pos, T&& theData)
+{
+	return emplace(pos, std::move(theData));
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::pop_front() {
+	if (empty()) {
+		return;
+	}
+	do_pop_front();
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::pop_back() {
+	if (!head) return;
+
+	if (head.get() == tail) {
+		do_pop_front();
+		return;
+	}
+
+	Node* previous = nullptr;
+	if constexpr (BackLinks) {
+		previous = tail->previous;
+	}
+	else {
+		previous = head.get();
+		while (previous->next.get() != tail) {
+			previous = previous->next.get();
+		}
+	}
+
+	tail = previous;
+	previous->next = nullptr;
+	--length;
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::erase_after(const_iterator pos) {
+	if (pos.before_begin) {
+		pop_front();
+		return begin();
+	}
+
+	if (pos.node && pos.node->next) {
+		pos.node->next = std::move(pos.node->next->next);
+		link_back(pos.node->next.get(), pos.node);
+		if (!pos.node->next) tail = pos.node;
+		--length;
+		return { pos.node->next.get() };
+	}
+
+	return end();
+}
+
+template <class T, class Allocator, bool BackLinks>
+bool SingleLinkedList<T, Allocator, BackLinks>::search(const T &x) {
+	return detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&x](const Node* node) { return node->data == x; }) != nullptr;
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::size_type SingleLinkedList<T, Allocator, BackLinks>::count(const T &x) const {
+	return static_cast<size_type>(std::count(begin(), end(), x));
+}
+
+template <class T, class Allocator, bool BackLinks>
+template <typename Predicate>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::find_if(Predicate pred) {
+	return std::find_if(begin(), end(), pred);
+}
+
+// Calls f on every element in order, prefetching Distance nodes ahead, see Prefetch.h
+template <class T, class Allocator, bool BackLinks>
+template <std::size_t Distance, typename Function>
+void SingleLinkedList<T, Allocator, BackLinks>::for_each(Function f) {
+	detail::find_prefetched<Distance>(head.get(), next_of, [&f](Node* node) { f(node->data); return false; });
+}
+
+template <class T, class Allocator, bool BackLinks>
+template <std::size_t Distance, typename Function>
+void SingleLinkedList<T, Allocator, BackLinks>::for_each(Function f) const {
+	detail::find_prefetched<Distance>(head.get(), next_of, [&f](const Node* node) { f(static_cast<const T&>(node->data)); return false; });
+}
+
+// One pass over the chain, each element is checked against all of the keys at once
+template <class T, class Allocator, bool BackLinks>
+template <typename InputIt>
+bool SingleLinkedList<T, Allocator, BackLinks>::contains_any(InputIt first, InputIt last) const {
+	const std::vector<T> keys(first, last);
+	const T* keys_begin = keys.data();
+	const T* keys_end = keys_begin + keys.size();
+	if (keys_begin == keys_end) return false;
+
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		if (simd::find(keys_begin, keys_end, current->data) != keys_end) return true;
+	}
+	return false;
+}
+
+// One pass over the chain for all of the keys, see KeySet.h. The walk stops early once
+// every key has been found. Returns, per key in the order given, whether it is in the list
+template <class T, class Allocator, bool BackLinks>
+template <typename InputIt>
+std::vector<bool> SingleLinkedList<T, Allocator, BackLinks>::search_many(InputIt first, InputIt last) const {
+	detail::KeySet<T> keys(first, last);
+	if (!keys.done()) {
+		detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&keys](const Node* node) { return keys.mark(node->data); });
+	}
+	return keys.found();
+}
+
+// Every element pred accepts, in list order
+template <class T, class Allocator, bool BackLinks>
+template <typename Predicate>
+std::vector<typename SingleLinkedList<T, Allocator, BackLinks>::iterator> SingleLinkedList<T, Allocator, BackLinks>::find_all(Predicate pred) {
+	std::vector<iterator> matches;
+	detail::find_prefetched<detail::prefetch_distance>(head.get(), next_of, [&](Node* node) {
+		if (pred(node->data)) matches.push_back(iterator{ node });
+		return false;
+	});
+	return matches;
+}
+
+// Moves the nodes of the sorted chain second into the sorted chain first. Runs that are
+// already in order are skipped without writing a link, and first wins ties so the merge
+// is stable. Back pointers are kept up to date, tail is left to the caller. If comp
+// throws every node is still owned by one of the two chains.
+template <class T, class Allocator, bool BackLinks>
+template <typename Compare>
+void SingleLinkedList<T, Allocator, BackLinks>::merge_chains(node_ptr &first, node_ptr &second, Compare &comp) {
+	Node* previous = nullptr;
+	node_ptr* link = &first;
+	while (*link && second) {
+		if (comp(second->data, (*link)->data)) {
+			node_ptr node = std::move(second);
+			second = std::move(node->next);
+			node->next = std::move(*link);
+			link_back(node->next.get(), node.get());
+			link_back(node.get(), previous);
+			*link = std::move(node);
+		}
+		previous = link->get();
+		link = &(*link)->next;
+	}
+	if (second) {
+		link_back(second.get(), previous);
+		*link = std::move(second);
+	}
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::append_chain(node_ptr &chain, node_ptr &&rest) noexcept {
+	node_ptr* link = &chain;
+	while (*link) link = &(*link)->next;
+	*link = std::move(rest);
+}
+
+// Walks the chain once to fix tail and the back pointers after nodes got relinked
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::restore_links() noexcept {
+	Node* previous = nullptr;
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		link_back(current, previous);
+		previous = current;
+	}
+	tail = previous;
+}
+
+// Bottom-up merge sort that only relinks nodes: no allocation, no element moves and
+// no recursion. bins[i] is empty or holds a sorted run of 2^i nodes, so 64 bins cover
+// any list that fits in memory. If comp throws the list keeps all of its elements in
+// an unspecified order.
+template <class T, class Allocator, bool BackLinks>
+template <typename Compare>
+void SingleLinkedList<T, Allocator, BackLinks>::sort(Compare comp) {
+	if (!head || !head->next) return;
+
+	node_ptr bins[64];
+	node_ptr rest = std::move(head);
+	node_ptr carry;
+
+	try {
+		while (rest) {
+			carry = std::move(rest);
+			rest = std::move(carry->next);
+
+			std::size_t i = 0;
+			for (; bins[i]; ++i) {
+				merge_chains(bins[i], carry, comp);		// bins[i] holds the earlier elements
+				carry = std::move(bins[i]);
+			}
+			bins[i] = std::move(carry);
+		}
+
+		for (auto& bin : bins) {
+			if (!bin) continue;
+			merge_chains(bin, carry, comp);
+			carry = std::move(bin);
+		}
+		head = std::move(carry);
+	}
+	catch (...) {
+		head = std::move(rest);
+		append_chain(head, std::move(carry));
+		for (auto& bin : bins) append_chain(head, std::move(bin));
+		restore_links();
+		throw;
+	}
+	restore_links();
+}
+
+// Merges the sorted other into this sorted list and leaves other empty. The allocators
+// have to compare equal, as for std::list::merge.
+template <class T, class Allocator, bool BackLinks>
+template <typename Compare>
+void SingleLinkedList<T, Allocator, BackLinks>::merge(SingleLinkedList &other, Compare comp) {
+	if (&other == this || !other.head) return;
+
+	try {
+		merge_chains(head, other.head, comp);
+	}
+	catch (...) {
+		length = count_nodes();
+		other.length = other.count_nodes();
+		restore_links();
+		other.restore_links();
+		throw;
+	}
+	if (!tail || tail->next) tail = other.tail;		// the last node came from other
+	length += other.length;
+	other.length = 0;
+	other.tail = nullptr;
+}
+
+template <class T, class Allocator, bool BackLinks>
+template <typename Compare>
+void SingleLinkedList<T, Allocator, BackLinks>::merge(SingleLinkedList &&other, Compare comp) {
+	merge(other, std::move(comp));
+}
+
+// Takes the nodes from the one from owns through last out of the list, owner is the
+// node that holds from or null for head
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::node_ptr SingleLinkedList<T, Allocator, BackLinks>::detach(node_ptr &from, Node* owner, Node* last) noexcept {
+	node_ptr chain = std::move(from);
+	from = std::move(last->next);
+	link_back(from.get(), owner);
+	if (!from) tail = owner;
+	return chain;
+}
+
+// Links a chain that ends in last right after pos
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::attach(const_iterator pos, node_ptr chain, Node* last) noexcept {
+	Node* owner = pos.before_begin ? nullptr : pos.node;
+	node_ptr& link = owner ? owner->next : head;
+
+	link_back(chain.get(), owner);
+	last->next = std::move(link);
+	link_back(last->next.get(), last);
+	if (!last->next) tail = last;
+	link = std::move(chain);
+}
+
+// The splice_after overloads move nodes from other to just after pos without touching
+// the elements, so iterators to them stay valid and now point into this list. As with
+// std::forward_list the allocators have to compare equal.
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::splice_after(const_iterator pos, SingleLinkedList &other) noexcept {
+	if (&other == this || !other.head) return;
+
+	Node* last = other.tail;
+	attach(pos, std::move(other.head), last);
+	length += other.length;
+	other.tail = nullptr;
+	other.length = 0;
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::splice_after(const_iterator pos, SingleLinkedList &&other) noexcept {
+	splice_after(pos, other);
+}
+
+// Moves the element after it
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::splice_after(const_iterator pos, SingleLinkedList &other, const_iterator it) noexcept {
+	Node* owner = it.before_begin ? nullptr : it.node;
+	node_ptr& from = owner ? owner->next : other.head;
+	Node* node = from.get();
+	if (!node || pos == it || (!pos.before_begin && pos.node == node)) return;
+
+	attach(pos, other.detach(from, owner, node), node);
+	++length;
+	--other.length;
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::splice_after(const_iterator pos, SingleLinkedList &&other, const_iterator it) noexcept {
+	splice_after(pos, other, it);
+}
+
+// Moves the elements in (first, last), finding the last of them makes it linear
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::splice_after(const_iterator pos, SingleLinkedList &other, const_iterator first, const_iterator last) noexcept {
+	Node* owner = first.before_begin ? nullptr : first.node;
+	node_ptr& from = owner ? owner->next : other.head;
+
+	Node* last_node = nullptr;
+	std::size_t moved = 0;
+	for (Node* node = from.get(); node != last.node; node = node->next.get()) {
+		last_node = node;
+		++moved;
+	}
+	if (!last_node || pos == first) return;
+
+	attach(pos, other.detach(from, owner, last_node), last_node);
+	length += moved;
+	other.length -= moved;
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::splice_after(const_iterator pos, SingleLinkedList &&other, const_iterator first, const_iterator last) noexcept {
+	splice_after(pos, other, first, last);
+}
+
+// Allocates and links the nodes for [first, last) without touching the list. Nothing
+// leaks if an element throws, and the chain is freed node by node so a long one can
+// not overflow the stack. A forward range is read with prefetching, see Prefetch.h.
+template <class T, class Allocator, bool BackLinks>
+template <typename InputIt>
+typename SingleLinkedList<T, Allocator, BackLinks>::node_ptr SingleLinkedList<T, Allocator, BackLinks>::build_chain(InputIt first, InputIt last, Node* &chain_tail, std::size_t &built) {
+	node_ptr chain;
+	node_ptr* link = &chain;
+	Node* previous = nullptr;
+	built = 0;
+
+	try {
+		detail::for_each_prefetched<detail::prefetch_distance>(first, last, [&](auto&& item) {
+			*link = make_node(std::forward<decltype(item)>(item));
+			link_back(link->get(), previous);
+			previous = link->get();
+			link = &previous->next;
+			++built;
+		});
+	}
+	catch (...) {
+		free_chain(std::move(chain));
+		throw;
+	}
+	chain_tail = previous;
+	return chain;
+}
+
+// Walks the chain with raw pointers, an allocator that can take the whole
+// chain back in one call gets it that way
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::free_chain(node_ptr chain) noexcept {
+	NodeDeleter deleter = chain.get_deleter();
+	Node* current = chain.release();
+
+	if constexpr (detail::has_deallocate_chain<node_allocator>::value) {
+		deleter.deallocate_chain(current, [&deleter](Node* node) noexcept {
+			Node* next = node->next.release();
+			if constexpr (!std::is_trivially_destructible<T>::value) node_traits::destroy(deleter, node);
+			return next;
+		});
+	}
+	else {
+		while (current) {
+			Node* next = current->next.release();
+			deleter(current);
+			current = next;
+		}
+	}
+}
+
+// Frees every node after last_kept, or all of them if it is null
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::truncate(Node* last_kept, std::size_t kept) noexcept {
+	node_ptr& rest = last_kept ? last_kept->next : head;
+	free_chain(std::move(rest));
+	tail = last_kept;
+	length = kept;
+}
+
+// Reuses the nodes already in the list, then appends or drops the difference
+template <class T, class Allocator, bool BackLinks>
+template <typename InputIt, typename>
+void SingleLinkedList<T, Allocator, BackLinks>::assign(InputIt first, InputIt last) {
+	Node* previous = nullptr;
+	size_type kept = 0;
+	for (Node* current = head.get(); current != nullptr && first != last; current = current->next.get(), ++first) {
+		current->data = *first;
+		previous = current;
+		++kept;
+	}
+
+	if (first != last) append_range(first, last);
+	else truncate(previous, kept);
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::assign(size_type count, const T &value) {
+	Node* previous = nullptr;
+	size_type kept = 0;
+	for (Node* current = head.get(); current != nullptr && kept < count; current = current->next.get()) {
+		current->data = value;
+		previous = current;
+		++kept;
+	}
+	if (kept == count) {
+		truncate(previous, kept);
+		return;
+	}
+
+	node_ptr chain;
+	node_ptr* link = &chain;
+	Node* chain_tail = nullptr;
+	try {
+		for (size_type i = kept; i < count; ++i) {
+			*link = make_node(value);
+			link_back(link->get(), chain_tail);
+			chain_tail = link->get();
+			link = &chain_tail->next;
+		}
+	}
+	catch (...) {
+		free_chain(std::move(chain));
+		throw;
+	}
+	attach(tail ? const_iterator{ tail } : cbefore_begin(), std::move(chain), chain_tail);
+	length = count;
+}
+
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::assign(std::initializer_list<T> init) {
+	assign(init.begin(), init.end());
+}
+
+// Builds the new nodes as one chain and links it in once, returns the last one inserted
+template <class T, class Allocator, bool BackLinks>
+template <typename InputIt, typename>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::insert_range_after(const_iterator pos, InputIt first, InputIt last) {
+	if (!pos.before_begin && !pos.node) throw std::out_of_range{ "end iterator got passed to insert!" };
+
+	Node* chain_tail = nullptr;
+	std::size_t built = 0;
+	node_ptr chain = build_chain(first, last, chain_tail, built);
+	if (!chain) return { pos.node, pos.before_begin };
+
+	attach(pos, std::move(chain), chain_tail);
+	length += built;
+	return { chain_tail };
+}
+
+template <class T, class Allocator, bool BackLinks>
+template <typename InputIt, typename>
+void SingleLinkedList<T, Allocator, BackLinks>::append_range(InputIt first, InputIt last) {
+	insert_range_after(tail ? const_iterator{ tail } : cbefore_begin(), first, last);
+}
+
+// Storage for a node that relayout_after() is about to fill, next to the last one
+// if the allocator can place it there
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::Node* SingleLinkedList<T, Allocator, BackLinks>::allocate_fresh_node() {
+	if constexpr (detail::has_allocate_fresh<node_allocator>::value) return alloc.allocate_fresh();
+	else return node_traits::allocate(alloc, 1);
+}
+
+// Moves every element into new nodes allocated in list order, see relayout_after()
+template <class T, class Allocator, bool BackLinks>
+void SingleLinkedList<T, Allocator, BackLinks>::relayout() {
+	relayout_after(cbefore_begin(), length);
+}
+
+// Moves up to max_nodes elements after pos into new nodes and frees the old ones, so
+// that walking them touches memory in order again once inserts and erases have
+// scattered the nodes. The storage for the whole batch is taken before any old node is
+// freed, which keeps the allocator from handing the old nodes straight back. With
+// PoolAllocator the new nodes sit back to back in a chunk; other allocators place
+// them as close as consecutive allocations get.
+//
+// Returns an iterator to the last node moved, to pass in as pos on the next call, or
+// end() once the end of the list was reached; pos itself if max_nodes is 0. Iterators and references to the moved
+// elements are invalidated. If moving an element throws, the elements before it have
+// been moved and the list is otherwise unchanged.
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::relayout_after(const_iterator pos, size_type max_nodes) {
+	if (!pos.before_begin && !pos.node) return end();
+	if (max_nodes == 0) return { pos.node, pos.before_begin };
+
+	Node* owner = pos.before_begin ? nullptr : pos.node;
+	node_ptr* link = owner ? &owner->next : &head;
+
+	size_type moving = 0;
+	for (Node* node = link->get(); node != nullptr && moving < max_nodes; node = node->next.get()) ++moving;
+
+	std::vector<Node*> fresh;
+	fresh.reserve(moving);
+	try {
+		while (fresh.size() < moving) fresh.push_back(allocate_fresh_node());
+	}
+	catch (...) {
+		for (Node* node : fresh) node_traits::deallocate(alloc, node, 1);
+		throw;
+	}
+
+	size_type moved = 0;
+	try {
+		for (; moved < moving; ++moved) {
+			Node* old = link->get();
+			Node* node = fresh[moved];
+			node_traits::construct(alloc, node, std::move_if_noexcept(old->data));
+			node->next = std::move(old->next);
+			link_back(node, owner);
+			link_back(node->next.get(), node);
+			if (old == tail) tail = node;
+			*link = node_ptr{ node, NodeDeleter{ alloc } };		// frees old
+			owner = node;
+			link = &node->next;
+		}
+	}
+	catch (...) {
+		for (; moved < moving; ++moved) node_traits::deallocate(alloc, fresh[moved], 1);
+		throw;
+	}
+
+	if (moving == 0 || !owner->next) return end();
+	return { owner };
+}
+
+// The fraction of links that don't lead just past their own node, within a cache line
+// of its end. 0 when list order is memory order, growing towards 1 as inserts and
+// erases scatter the nodes; one way to decide when relayout() is worth its cost. A
+// count rather than a mean distance, so a few jumps between far apart regions don't
+// outweigh the rest of the list. 0 for fewer than two elements.
+template <class T, class Allocator, bool BackLinks>
+double SingleLinkedList<T, Allocator, BackLinks>::scattered_link_fraction() const noexcept {
+	if (length < 2) return 0.0;
+
+	constexpr std::uintptr_t nearby = sizeof(Node) + 64;
+	size_type scattered = 0;
+	for (const Node* node = head.get(); node->next != nullptr; node = node->next.get()) {
+		const std::uintptr_t from = reinterpret_cast<std::uintptr_t>(node);
+		const std::uintptr_t to = reinterpret_cast<std::uintptr_t>(node->next.get());
+		if (to <= from || to - from > nearby) ++scattered;
+	}
+	return double(scattered) / double(length - 1);
+}
+
+template <class T, class Allocator, bool BackLinks>
+std::ostream& operator<<(std::ostream &str, SingleLinkedList<T, Allocator, BackLinks>& list) {
+	list.for_each([&str](const T& item) { str << item << "\t"; });
+	return str;
+}
+
+// Iterator Implementaion////////////////////////////////////////////////
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator& SingleLinkedList<T, Allocator, BackLinks>::iterator::operator++() {
+	if (before_begin) before_begin = false;
+	else node = node->next.get();
+
+	return *this;
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, class Allocator, bool BackLinks>
+bool SingleLinkedList<T, Allocator, BackLinks>::iterator::operator==(iterator other) const noexcept {
+	return node == other.node && before_begin == other.before_begin;
+}
+
+template <class T, class Allocator, bool BackLinks>
+bool SingleLinkedList<T, Allocator, BackLinks>::iterator::operator!=(iterator other) const noexcept {
+	return !(*this == other);
+}
+
+
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::begin() {
+	return head.get();
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::end() {
+	return {};
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::iterator SingleLinkedList<T, Allocator, BackLinks>::before_begin() {
+	return { head.get(), true };
+}
+
+// Const Iterator Implementaion////////////////////////////////////////////////
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator& SingleLinkedList<T, Allocator, BackLinks>::const_iterator::operator++() {
+	if (before_begin) before_begin = false;
+	else node = node->next.get();
+
+	return *this;
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator SingleLinkedList<T, Allocator, BackLinks>::const_iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, class Allocator, bool BackLinks>
+bool SingleLinkedList<T, Allocator, BackLinks>::const_iterator::operator==(const_iterator other) const noexcept {
+	return node == other.node && before_begin == other.before_begin;
+}
+
+template <class T, class Allocator, bool BackLinks>
+bool SingleLinkedList<T, Allocator, BackLinks>::const_iterator::operator!=(const_iterator other) const noexcept {
+	return !(*this == other);
+}
+
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator SingleLinkedList<T, Allocator, BackLinks>::begin() const {
+	return head.get();
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator SingleLinkedList<T, Allocator, BackLinks>::end() const {
+	return {};
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator SingleLinkedList<T, Allocator, BackLinks>::cbegin() const {
+	return begin();
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator SingleLinkedList<T, Allocator, BackLinks>::cend() const {
+	return end();
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator SingleLinkedList<T, Allocator, BackLinks>::before_begin() const {
+	return { head.get(), true };
+}
+
+template <class T, class Allocator, bool BackLinks>
+typename SingleLinkedList<T, Allocator, BackLinks>::const_iterator SingleLinkedList<T, Allocator, BackLinks>::cbefore_begin() const {
+	return before_begin();
+}
+
 #endif /* SingleLinkedList_h*/
\ No newline at end of file
@@ -0,0 +1,652 @@
+//
+//  UnrolledLinkedList.h
+//  Data Structure - LinkedList
+//
+// A singly linked list that stores up to N elements per node in a contiguous
+// block. It offers the same interface as SingleLinkedList, but a traversal
+// chases one pointer per N elements instead of one per element.
+//
+// Nodes split in half when an insert hits a full node and a node that drops
+// below half full absorbs its successor when both fit, so nodes stay at least
+// half full under mixed inserts and erases.
+//
+// Unlike SingleLinkedList, inserts and erases move the elements that share a
+// block with the one inserted or erased. An iterator is a block and an index,
+// so iterators, pointers and references to the elements behind it in that block
+// are invalidated; an insert that splits the block also invalidates those that
+// move to the new block, and an erase that absorbs the next block invalidates
+// those to its elements. push_back and emplace_back only append and keep every
+// iterator valid.
+//
+
+#ifndef UNROLLEDLINKEDLIST_h
+#define UNROLLEDLINKEDLIST_h
+
+#include "SimdSearch.h"
+
+
+template <class T, std::size_t N = 16, class Allocator = std::allocator<T>>
+class UnrolledLinkedList {
+	static_assert(N > 1, "an unrolled node has to hold at least two elements");
+
+private:
+
+	struct Node;
+	using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
+	// Each link hands its node back to the allocator it came from
+	struct NodeDeleter : node_allocator {
+		NodeDeleter() = default;
+		NodeDeleter(const node_allocator& alloc) : node_allocator(alloc) {}
+
+		void operator()(Node* node) noexcept {
+			node_traits::destroy(*this, node);
+			node_traits::deallocate(*this, node, 1);
+		}
+	};
+	using node_ptr = std::unique_ptr<Node, NodeDeleter>;
+
+	struct Node {
+		node_ptr next = nullptr;
+		std::size_t count = 0;
+		alignas(T) unsigned char storage[N * sizeof(T)];
+
+		explicit Node(node_ptr&& next = nullptr) noexcept : next{ std::move(next) } {}
+		Node(const Node&) = delete;
+		Node& operator=(const Node&) = delete;
+		~Node() { std::destroy(items(), items() + count); }
+
+		T* items() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+		const T* items() const noexcept { return std::launder(reinterpret_cast<const T*>(storage)); }
+	};
+	node_ptr head = nullptr;
+	Node* tail = nullptr;
+	std::size_t length = 0;
+	node_allocator alloc;
+
+	node_ptr make_node(node_ptr&& next = nullptr);
+
+	std::size_t count_nodes() const;
+
+	template <typename... Args>
+	T* insert_into(Node* node, std::size_t index, Args&&... args);
+	Node* split(Node* node);
+	void absorb_next(Node* node);
+
+public:
+	// Constructors
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	UnrolledLinkedList() = default;                                             // empty constructor
+	explicit UnrolledLinkedList(const Allocator &alloc);                       // empty constructor with allocator
+	UnrolledLinkedList(UnrolledLinkedList const &source);                       // copy constructor
+
+																				// Rule of 5
+	UnrolledLinkedList(UnrolledLinkedList &&move) noexcept;                     // move constructor
+	UnrolledLinkedList& operator=(UnrolledLinkedList &&move) noexcept;          // move assignment operator
+	~UnrolledLinkedList() noexcept;
+
+	// Overload operators
+	UnrolledLinkedList& operator=(UnrolledLinkedList const &rhs);
+
+	// Create an iterator class
+	class iterator;
+	iterator begin();
+	iterator end();
+	iterator before_begin();
+
+	// Create const iterator class
+	class const_iterator;
+	const_iterator cbegin() const;
+	const_iterator cend() const;
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_iterator before_begin() const;
+	const_iterator cbefore_begin() const;
+
+	// Memeber functions
+	void swap(UnrolledLinkedList &other) noexcept;
+	allocator_type get_allocator() const { return allocator_type(alloc); }
+	bool empty() const { return head.get() == nullptr; }
+	size_type size() const noexcept;
+	static constexpr size_type node_capacity() noexcept { return N; }
+
+	template<typename... Args>
+	void emplace_back(Args&&... args);
+
+	template<typename... Args>
+	void emplace_front(Args&&... args);
+
+	template<typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args);
+
+	void push_back(const T &theData);
+	void push_back(T &&theData);
+	void push_front(const T &theData);
+	void push_front(T &&theData);
+	iterator insert_after(const_iterator pos, const T& theData);
+	iterator insert_after(const_iterator pos, T&& theData);
+	void clear();
+	void pop_front();
+	void pop_back();
+	iterator erase_after(const_iterator pos);
+	bool search(const T &x);
+	size_type count(const T &x) const;
+
+	template<typename Predicate>
+	iterator find_if(Predicate pred);
+
+	template<typename InputIt>
+	bool contains_any(InputIt first, InputIt last) const;
+
+private:
+	iterator erase_at(Node* previous, Node* node, std::size_t index);
+};
+
+template <class T, std::size_t N, class Allocator>
+class UnrolledLinkedList<T, N, Allocator>::iterator {
+	Node* node = nullptr;
+	std::size_t index = 0;
+	bool before_begin = false;
+
+public:
+	friend class UnrolledLinkedList<T, N, Allocator>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = T * ;
+	using reference = T & ;
+
+	iterator(Node* node = nullptr, std::size_t index = 0, bool before = false) : node{ node }, index{ index }, before_begin{ before } {}
+
+	operator const_iterator() const noexcept { return const_iterator{ node, index, before_begin }; }
+	bool operator!=(iterator other) const noexcept;
+	bool operator==(iterator other) const noexcept;
+
+	T& operator*() const { return node->items()[index]; }
+	T* operator->() const { return &node->items()[index]; }
+
+	iterator& operator++();
+	iterator operator++(int);
+};
+
+template <class T, std::size_t N, class Allocator>
+class UnrolledLinkedList<T, N, Allocator>::const_iterator {
+	Node* node = nullptr;
+	std::size_t index = 0;
+	bool before_begin = false;
+
+public:
+	friend class UnrolledLinkedList<T, N, Allocator>;
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const T * ;
+	using reference = const T & ;
+
+	const_iterator() = default;
+	const_iterator(Node* node, std::size_t index = 0, bool before = false) : node{ node }, index{ index }, before_begin{ before } {}
+
+	bool operator!=(const_iterator other) const noexcept;
+	bool operator==(const_iterator other) const noexcept;
+
+	const T& operator*() const { return node->items()[index]; }
+	const T* operator->() const { return &node->items()[index]; }
+
+	const_iterator& operator++();
+	const_iterator operator++(int);
+};
+
+
+template <class T, std::size_t N, class Allocator>
+UnrolledLinkedList<T, N, Allocator>::UnrolledLinkedList(const Allocator &alloc) : alloc{ alloc } {}
+
+template <class T, std::size_t N, class Allocator>
+UnrolledLinkedList<T, N, Allocator>::UnrolledLinkedList(UnrolledLinkedList const &source)
+	: alloc{ node_traits::select_on_container_copy_construction(source.alloc) } {
+	// Copy block by block, the chunking of the source is kept as it is
+	for (Node* loop = source.head.get(); loop != nullptr; loop = loop->next.get()) {
+		node_ptr newNode = make_node();
+		std::uninitialized_copy(loop->items(), loop->items() + loop->count, newNode->items());
+		newNode->count = loop->count;
+
+		if (!head) {
+			head = std::move(newNode);
+			tail = head.get();
+		}
+		else {
+			tail->next = std::move(newNode);
+			tail = tail->next.get();
+		}
+		length += loop->count;
+	}
+}
+
+template <class T, std::size_t N, class Allocator>
+UnrolledLinkedList<T, N, Allocator>::UnrolledLinkedList(UnrolledLinkedList&& move) noexcept {
+	move.swap(*this);
+}
+
+template <class T, std::size_t N, class Allocator>
+UnrolledLinkedList<T, N, Allocator>& UnrolledLinkedList<T, N, Allocator>::operator=(UnrolledLinkedList &&move) noexcept {
+	move.swap(*this);
+	return *this;
+}
+
+template <class T, std::size_t N, class Allocator>
+UnrolledLinkedList<T, N, Allocator>::~UnrolledLinkedList() noexcept {
+	clear();
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::clear() {
+	// Unlink one node at a time so destroying a long chain does not recurse
+	while (head) {
+		head = std::move(head->next);
+	}
+	tail = nullptr;
+	length = 0;
+}
+
+template <class T, std::size_t N, class Allocator>
+UnrolledLinkedList<T, N, Allocator>& UnrolledLinkedList<T, N, Allocator>::operator=(UnrolledLinkedList const &rhs) {
+	UnrolledLinkedList copy{ rhs };
+	swap(copy);
+	return *this;
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::swap(UnrolledLinkedList &other) noexcept {
+	using std::swap;
+	swap(head, other.head);
+	swap(tail, other.tail);
+	swap(length, other.length);
+	swap(alloc, other.alloc);
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::size_type UnrolledLinkedList<T, N, Allocator>::size() const noexcept {
+	assert(length == count_nodes() && "cached size is out of sync with the chain");
+	return length;
+}
+
+template <class T, std::size_t N, class Allocator>
+std::size_t UnrolledLinkedList<T, N, Allocator>::count_nodes() const {
+	std::size_t elements = 0;
+	for (auto current = head.get(); current != nullptr; current = current->next.get()) {
+		elements += current->count;
+	}
+	return elements;
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::node_ptr UnrolledLinkedList<T, N, Allocator>::make_node(node_ptr&& next) {
+	Node* node = node_traits::allocate(alloc, 1);
+	node_traits::construct(alloc, node, std::move(next));		// Node's constructor is noexcept
+	return { node, NodeDeleter{ alloc } };
+}
+
+// Builds a new element at index of a node that still has room
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+T* UnrolledLinkedList<T, N, Allocator>::insert_into(Node* node, std::size_t index, Args&&... args) {
+	T* items = node->items();
+
+	if (index == node->count) {
+		::new (static_cast<void*>(items + index)) T(std::forward<Args>(args)...);
+	}
+	else {
+		T value(std::forward<Args>(args)...);		// a throwing constructor leaves the node untouched
+		::new (static_cast<void*>(items + node->count)) T(std::move(items[node->count - 1]));
+		std::move_backward(items + index, items + node->count - 1, items + node->count);
+		items[index] = std::move(value);
+	}
+
+	++node->count;
+	++length;
+	return items + index;
+}
+
+// Moves the upper half of a full node into a fresh node linked right after it
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::Node* UnrolledLinkedList<T, N, Allocator>::split(Node* node) {
+	constexpr std::size_t keep = N / 2;
+
+	node_ptr fresh = make_node(std::move(node->next));
+	std::uninitialized_move(node->items() + keep, node->items() + node->count, fresh->items());
+	fresh->count = node->count - keep;
+	std::destroy(node->items() + keep, node->items() + node->count);
+	node->count = keep;
+
+	node->next = std::move(fresh);
+	if (node == tail) tail = node->next.get();
+	return node->next.get();
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::absorb_next(Node* node) {
+	Node* next = node->next.get();
+	std::uninitialized_move(next->items(), next->items() + next->count, node->items() + node->count);
+	node->count += next->count;
+	std::destroy(next->items(), next->items() + next->count);
+	next->count = 0;
+
+	if (next == tail) tail = node;
+	node->next = std::move(next->next);
+}
+
+// Removes items()[index] from node; previous is the node before it, or nullptr for head
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::erase_at(Node* previous, Node* node, std::size_t index) {
+	T* items = node->items();
+	std::move(items + index + 1, items + node->count, items + index);
+	items[node->count - 1].~T();
+	--node->count;
+	--length;
+
+	if (node->count == 0) {
+		Node* next = node->next.get();
+		if (tail == node) tail = previous;
+		if (previous) previous->next = std::move(node->next);
+		else head = std::move(node->next);
+		return { next };
+	}
+
+	if (node->count < N / 2 && node->next && node->count + node->next->count <= N) {
+		absorb_next(node);
+	}
+
+	if (index < node->count) return { node, index };
+	return { node->next.get() };
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+void UnrolledLinkedList<T, N, Allocator>::emplace_back(Args&&... args) {
+	if (!tail) {
+		head = make_node();
+		tail = head.get();
+	}
+	else if (tail->count == N) {
+		tail->next = make_node();
+		tail = tail->next.get();
+	}
+	insert_into(tail, tail->count, std::forward<Args>(args)...);
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+void UnrolledLinkedList<T, N, Allocator>::emplace_front(Args&&... args) {
+	if (!head || head->count == N) {
+		head = make_node(std::move(head));
+		if (!tail) tail = head.get(); // update tail if list was empty before
+	}
+	insert_into(head.get(), 0, std::forward<Args>(args)...);
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::emplace(const_iterator pos, Args&&... args) {
+	if (pos.before_begin) {
+		emplace_front(std::forward<Args>(args)...);
+		return begin();
+	}
+
+	if (!pos.node) {
+		throw std::out_of_range{ "end iterator got passed to insert!" };
+	}
+
+	Node* node = pos.node;
+	std::size_t index = pos.index + 1;
+
+	if (node->count == N) {
+		if (index == N && node == tail) {		// appending, start a new block instead of splitting
+			emplace_back(std::forward<Args>(args)...);
+			return { tail, 0 };
+		}
+
+		Node* upper = split(node);
+		if (index > node->count) {
+			index -= node->count;
+			node = upper;
+		}
+	}
+
+	insert_into(node, index, std::forward<Args>(args)...);
+	return { node, index };
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::push_back(const T &theData) {
+	emplace_back(theData);
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::push_back(T &&theData) {
+	emplace_back(std::move(theData));
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::push_front(const T &theData) {
+	emplace_front(theData);
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::push_front(T &&theData) {
+	emplace_front(std::move(theData));
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::insert_after(const_iterator pos, const T& theData) {
+	return emplace(pos, theData);
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::insert_after(const_iterator pos, T&& theData) {
+	return emplace(pos, std::move(theData));
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::pop_front() {
+	if (empty()) {
+		return;
+	}
+	erase_at(nullptr, head.get(), 0);
+}
+
+template <class T, std::size_t N, class Allocator>
+void UnrolledLinkedList<T, N, Allocator>::pop_back() {
+	if (!head) return;
+
+	// Only an emptied tail needs its predecessor, which costs a walk over the blocks
+	Node* previous = nullptr;
+	if (tail->count == 1) {
+		for (Node* current = head.get(); current != tail; current = current->next.get()) {
+			previous = current;
+		}
+	}
+	erase_at(previous, tail, tail->count - 1);
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::erase_after(const_iterator pos) {
+	if (pos.before_begin) {
+		pop_front();
+		return begin();
+	}
+
+	if (!pos.node) {
+		return end();
+	}
+
+	if (pos.index + 1 < pos.node->count) {
+		return erase_at(nullptr, pos.node, pos.index + 1);		// pos stays, so the node cannot empty
+	}
+
+	if (pos.node->next) {
+		return erase_at(pos.node, pos.node->next.get(), 0);
+	}
+
+	return end();
+}
+
+template <class T, std::size_t N, class Allocator>
+bool UnrolledLinkedList<T, N, Allocator>::search(const T &x) {
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		const T* items = current->items();
+		if (simd::find(items, items + current->count, x) != items + current->count) return true;
+	}
+	return false;
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::size_type UnrolledLinkedList<T, N, Allocator>::count(const T &x) const {
+	size_type matches = 0;
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		matches += simd::count(current->items(), current->items() + current->count, x);
+	}
+	return matches;
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename Predicate>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::find_if(Predicate pred) {
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		T* items = current->items();
+		T* found = std::find_if(items, items + current->count, pred);
+		if (found != items + current->count) return { current, static_cast<std::size_t>(found - items) };
+	}
+	return end();
+}
+
+// Every block is small enough to stay in cache while it is scanned once per key
+template <class T, std::size_t N, class Allocator>
+template <typename InputIt>
+bool UnrolledLinkedList<T, N, Allocator>::contains_any(InputIt first, InputIt last) const {
+	const std::vector<T> keys(first, last);
+	const T* keys_begin = keys.data();
+	const T* keys_end = keys_begin + keys.size();
+
+	for (Node* current = head.get(); current != nullptr; current = current->next.get()) {
+		if (simd::contains_any(current->items(), current->items() + current->count, keys_begin, keys_end)) return true;
+	}
+	return false;
+}
+
+template <class T, std::size_t N, class Allocator>
+std::ostream& operator<<(std::ostream &str, UnrolledLinkedList<T, N, Allocator>& list) {
+	for (auto const& item : list) {
+		str << item << "\t";
+	}
+	return str;
+}
+
+// Iterator Implementaion////////////////////////////////////////////////
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator& UnrolledLinkedList<T, N, Allocator>::iterator::operator++() {
+	if (before_begin) before_begin = false;
+	else if (++index == node->count) {
+		node = node->next.get();
+		index = 0;
+	}
+
+	return *this;
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, std::size_t N, class Allocator>
+bool UnrolledLinkedList<T, N, Allocator>::iterator::operator==(iterator other) const noexcept {
+	return node == other.node && index == other.index && before_begin == other.before_begin;
+}
+
+template <class T, std::size_t N, class Allocator>
+bool UnrolledLinkedList<T, N, Allocator>::iterator::operator!=(iterator other) const noexcept {
+	return !(*this == other);
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::begin() {
+	return head.get();
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::end() {
+	return {};
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::iterator UnrolledLinkedList<T, N, Allocator>::before_begin() {
+	return { head.get(), 0, true };
+}
+
+// Const Iterator Implementaion////////////////////////////////////////////////
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator& UnrolledLinkedList<T, N, Allocator>::const_iterator::operator++() {
+	if (before_begin) before_begin = false;
+	else if (++index == node->count) {
+		node = node->next.get();
+		index = 0;
+	}
+
+	return *this;
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator UnrolledLinkedList<T, N, Allocator>::const_iterator::operator++(int) {
+	auto copy = *this;
+	++*this;
+	return copy;
+}
+
+template <class T, std::size_t N, class Allocator>
+bool UnrolledLinkedList<T, N, Allocator>::const_iterator::operator==(const_iterator other) const noexcept {
+	return node == other.node && index == other.index && before_begin == other.before_begin;
+}
+
+template <class T, std::size_t N, class Allocator>
+bool UnrolledLinkedList<T, N, Allocator>::const_iterator::operator!=(const_iterator other) const noexcept {
+	return !(*this == other);
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator UnrolledLinkedList<T, N, Allocator>::begin() const {
+	return head.get();
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator UnrolledLinkedList<T, N, Allocator>::end() const {
+	return {};
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator UnrolledLinkedList<T, N, Allocator>::cbegin() const {
+	return begin();
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator UnrolledLinkedList<T, N, Allocator>::cend() const {
+	return end();
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator UnrolledLinkedList<T, N, Allocator>::before_begin() const {
+	return { head.get(), 0, true };
+}
+
+template <class T, std::size_t N, class Allocator>
+typename UnrolledLinkedList<T, N, Allocator>::const_iterator UnrolledLinkedList<T, N, Allocator>::cbefore_begin() const {
+	return before_begin();
+}
+
+#endif
@@ -0,0 +1,183 @@
+//
+//  WorkStealingPool.h
+//  Data Structure - LinkedList
+//
+// A fork-join thread pool for the parallel list algorithms. run(count, body)
+// calls body(0) .. body(count - 1) across the workers and returns once all
+// of them have finished.
+//
+// Every worker has its own task queue. A worker takes its newest task first
+// and, once its queue is empty, steals the oldest task from another one. The
+// thread that called run() steals as well instead of sleeping, so a pool with
+// no workers simply runs everything on the caller, and a body may call run()
+// again without deadlocking.
+//
+
+#ifndef WORKSTEALINGPOOL_h
+#define WORKSTEALINGPOOL_h
+
+
+class WorkStealingPool {
+public:
+	// threads workers besides the callers of run()
+	explicit WorkStealingPool(unsigned threads);
+	WorkStealingPool(WorkStealingPool const &) = delete;
+	WorkStealingPool& operator=(WorkStealingPool const &) = delete;
+	~WorkStealingPool();
+
+	// One worker per hardware thread except the caller's, started on first use
+	static WorkStealingPool& instance() {
+		static WorkStealingPool* pool = new WorkStealingPool(default_threads());		// never destroyed, the workers are parked at exit
+		return *pool;
+	}
+
+	// Threads that take part in a run(), the workers and the caller
+	unsigned concurrency() const noexcept { return static_cast<unsigned>(workers.size()) + 1; }
+
+	// Rethrows the first exception a body threw, after every body has finished
+	template <class Body>
+	void run(std::size_t count, Body&& body);
+
+private:
+	struct Group {
+		void (*call)(void*, std::size_t);
+		void* body;
+		std::atomic<std::size_t> remaining;
+		std::mutex error_mutex;
+		std::exception_ptr error;
+	};
+
+	struct Task {
+		Group* group;
+		std::size_t index;
+	};
+
+	struct alignas(64) Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	// One queue per worker, the last one is shared by the threads calling run()
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+	std::atomic<std::size_t> queued{ 0 };
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+	bool stopping = false;
+
+	static unsigned default_threads() {
+		const unsigned hardware = std::thread::hardware_concurrency();
+		return hardware > 1 ? hardware - 1 : 0;
+	}
+
+	void run_group(Group &group, std::size_t count);
+	bool take(std::size_t own, Task &task);
+	static void execute(const Task &task) noexcept;
+	void work(std::size_t own);
+};
+
+inline WorkStealingPool::WorkStealingPool(unsigned threads) {
+	for (unsigned i = 0; i <= threads; ++i) queues.push_back(std::make_unique<Queue>());
+	workers.reserve(threads);
+	for (unsigned i = 0; i < threads; ++i) workers.emplace_back([this, i] { work(i); });
+}
+
+inline WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> lock{ sleep_mutex };
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers) worker.join();
+}
+
+template <class Body>
+void WorkStealingPool::run(std::size_t count, Body&& body) {
+	if (count == 0) return;
+	if (count == 1 || workers.empty()) {
+		for (std::size_t i = 0; i < count; ++i) body(i);
+		return;
+	}
+
+	using body_type = std::remove_reference_t<Body>;
+	Group group;
+	group.call = [](void* erased, std::size_t index) { (*static_cast<body_type*>(erased))(index); };
+	group.body = const_cast<void*>(static_cast<const void*>(std::addressof(body)));
+	group.remaining.store(count, std::memory_order_relaxed);
+	run_group(group, count);
+
+	if (group.error) std::rethrow_exception(group.error);
+}
+
+// Deals the tasks out round robin, then helps until the group is done
+inline void WorkStealingPool::run_group(Group &group, std::size_t count) {
+	// Counted before they are queued, so queued never drops below the tasks still in the queues
+	queued.fetch_add(count, std::memory_order_relaxed);
+	for (std::size_t i = 0; i < count; ++i) {
+		Queue& queue = *queues[i % queues.size()];
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		queue.tasks.push_back({ &group, i });
+	}
+	{
+		// Taking the lock orders this with a worker that is about to wait
+		std::lock_guard<std::mutex> lock{ sleep_mutex };
+	}
+	wake.notify_all();
+
+	Task task;
+	while (group.remaining.load(std::memory_order_acquire) != 0) {
+		if (take(queues.size() - 1, task)) execute(task);
+		else std::this_thread::yield();
+	}
+}
+
+// Newest task from the own queue, otherwise the oldest from the next queue that has one
+inline bool WorkStealingPool::take(std::size_t own, Task &task) {
+	if (queued.load(std::memory_order_acquire) == 0) return false;
+
+	for (std::size_t offset = 0; offset < queues.size(); ++offset) {
+		Queue& queue = *queues[(own + offset) % queues.size()];
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		if (queue.tasks.empty()) continue;
+
+		if (offset == 0) {
+			task = queue.tasks.back();
+			queue.tasks.pop_back();
+		}
+		else {
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+		}
+		queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+inline void WorkStealingPool::execute(const Task &task) noexcept {
+	Group& group = *task.group;
+	try {
+		group.call(group.body, task.index);
+	}
+	catch (...) {
+		std::lock_guard<std::mutex> lock{ group.error_mutex };
+		if (!group.error) group.error = std::current_exception();
+	}
+	group.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+inline void WorkStealingPool::work(std::size_t own) {
+	Task task;
+	for (;;) {
+		if (take(own, task)) {
+			execute(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock{ sleep_mutex };
+		wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) != 0; });
+		if (stopping) return;
+	}
+}
+
+#endif
@@ -1,139 +1,393 @@
-//
-//  main.cpp
-//  Data Structure - LinkedList
-//
-//  Created by Morgan Weiss on 7/24/2018
-//  Copyright  2018 Morgan Weiss. All rights reserved.
-//
-
-
-#include <iostream>
-#include <iterator>
-#include <memory>
-#include <utility>
-#include <stdexcept>
-#include <iosfwd>
-#include <type_traits>
-#include <ostream>
-#include "SingleLinkedList.h"
-#include "DoubleLinkedList.h"
-
-int main(int argc, const char * argv[]) {
-
-
-	///////////////////////////////////////////////////////////////////////
-	///////////////////////////// Single Linked List //////////////////////
-	///////////////////////////////////////////////////////////////////////
-
-	SingleLinkedList<int> list1;
-	list1.emplace_back(2);
-	list1.emplace_back(4);
-	list1.emplace_back(6);
-	list1.emplace_back(8);
-	list1.emplace_back(10);
-	std::cout << list1 << "\n";
-	
-
-	std::cout<<"\n--------------------------------------------------\n";
-	std::cout<<"----------------Inserting At Start----------------";
-	std::cout<<"\n--------------------------------------------------\n";
-	list1.push_front(50);
-	std::cout << list1 << "\n";
-
-	std::cout<<"\n--------------------------------------------------\n";
-	std::cout<<"-------------inserting at particular--------------";
-	std::cout<<"\n--------------------------------------------------\n";
-	list1.insert_after(list1.cbegin(),60);
-	std::cout << list1 << "\n";
-
-	std::cout << "\n--------------------------------------------------\n";
-	std::cout << "-------------Get current size ---=--------------------";
-	std::cout << "\n--------------------------------------------------\n";
-	std::cout << list1.size() << "\n";
-	
-	std::cout<<"\n--------------------------------------------------\n";
-	std::cout<<"----------------deleting at start-----------------";
-	std::cout<<"\n--------------------------------------------------\n";
-	list1.pop_front();
-	std::cout << list1 << "\n";
-	
-	std::cout<<"\n--------------------------------------------------\n";
-	std::cout<<"----------------deleting at end-----------------------";
-	std::cout<<"\n--------------------------------------------------\n";
-	list1.pop_back();
-	std::cout << list1 << "\n";
-	
-	
-	std::cout<<"\n----------------------------------------------------------\n";
-	std::cout<<"--------------Deleting after particular position--------------";
-	std::cout<<"\n-----------------------------------------------------------\n";
-	list1.erase_after(list1.cend());
-	std::cout << list1 << "\n";
-	
-	 list1.search(8) ? printf("yes"):printf("no");
-
-	 std::cout << "\n--------------------------------------------------\n";
-	 std::cout << "--------------Testing copy----------------------------";
-	 std::cout << "\n--------------------------------------------------\n";
-	 SingleLinkedList<int> list11 = list1;
-	 std::cout << list11 << "\n";
-
-	 ///////////////////////////////////////////////////////////////////////
-	 ///////////////////////////// Double Linked List //////////////////////
-	 ///////////////////////////////////////////////////////////////////////
-	 DoubleLinkedList<int> list2;
-	 list2.push_back(2);
-	 list2.push_back(4);
-	 list2.push_back(6);
-	 list2.push_back(8);
-	 list2.push_back(10);
-	 std::cout<<"\n--------------------------------------------------\n";
-	 std::cout<<"---------------displaying all nodes---------------";
-	 std::cout<<"\n--------------------------------------------------\n";
-	 std::cout << list2 << "\n";
-
-	 std::cout<<"\n--------------------------------------------------\n";
-	 std::cout<<"----------------Inserting At Start----------------";
-	 std::cout<<"\n--------------------------------------------------\n";
-	 list2.push_front(1);
-	 std::cout << list1 << "\n";
-
-	 std::cout << "\n--------------------------------------------------\n";
-	 std::cout << "-------------Get current size ---=--------------------";
-	 std::cout << "\n--------------------------------------------------\n";
-	 std::cout << list2.size() << "\n";
-
-	 std::cout<<"\n--------------------------------------------------\n";
-	 std::cout<<"----------------deleting at start-----------------";
-	 std::cout<<"\n--------------------------------------------------\n";
-	 list2.pop_front();
-	 std::cout << list2 << "\n";
-
-	 std::cout<<"\n--------------------------------------------------\n";
-	 std::cout<<"----------------deleting at end-----------------------";
-	 std::cout<<"\n--------------------------------------------------\n";
-	 list2.pop_back();
-	 std::cout << list1 << "\n";
-
-	 std::cout<<"\n--------------------------------------------------\n";
-	 std::cout<<"-------------inserting at particular--------------";
-	 std::cout<<"\n--------------------------------------------------\n";
-	 list2.insert(list2.cend(),60);
-	 std::cout << list1 << "\n";
-
-	 std::cout<<"\n----------------------------------------------------------\n";
-	 std::cout<<"--------------Deleting after particular position--------------";
-	 std::cout<<"\n-----------------------------------------------------------\n";
-	 list2.erase(list2.cend());
-	 std::cout << list1 << "\n";
-
-	  list2.search(8) ? printf("yes"):printf("no");
-
-	  std::cout << "\n--------------------------------------------------\n";
-	  std::cout << "--------------Testing copy----------------------------";
-	  std::cout << "\n--------------------------------------------------\n";
-	  DoubleLinkedList<int> list22 = list2;
-	  std::cout << list22 << "\n";
-
-	std::cin.get();
+//
+//  main.cpp
+//  Data Structure - LinkedList
+//
+//  Created by Morgan Weiss on 7/24/2018
+//  Copyright  2018 Morgan Weiss. All rights reserved.
+//
+
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <iosfwd>
+#include <type_traits>
+#include <unordered_map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include "PoolAllocator.h"
+#include "SingleLinkedList.h"
+#include "DoubleLinkedList.h"
+#include "UnrolledLinkedList.h"
+#include "ConcurrentSingleLinkedList.h"
+#include "IntrusiveSingleLinkedList.h"
+#include "IntrusiveDoubleLinkedList.h"
+#include "LinkedQueue.h"
+#include "OrderedLinkedList.h"
+#include "LinkedHashMap.h"
+#include "PersistentList.h"
+#include "ParallelAlgorithms.h"
+#include "ListSerialization.h"
+#include "CompactDoubleLinkedList.h"
+#include "IndexLinkedList.h"
+
+struct Session {
+	int id;
+	SingleLinkHook<Session> queue_hook;
+	DoubleLinkHook<Session> active_hook;
+};
+
+int main(int argc, const char * argv[]) {
+
+
+	///////////////////////////////////////////////////////////////////////
+	///////////////////////////// Single Linked List //////////////////////
+	///////////////////////////////////////////////////////////////////////
+
+	SingleLinkedList<int> list1;
+	list1.emplace_back(2);
+	list1.emplace_back(4);
+	list1.emplace_back(6);
+	list1.emplace_back(8);
+	list1.emplace_back(10);
+	std::cout << list1 << "\n";
+	
+
+	std::cout<<"\n--------------------------------------------------\n";
+	std::cout<<"----------------Inserting At Start----------------";
+	std::cout<<"\n--------------------------------------------------\n";
+	list1.push_front(50);
+	std::cout << list1 << "\n";
+
+	std::cout<<"\n--------------------------------------------------\n";
+	std::cout<<"-------------inserting at particular--------------";
+	std::cout<<"\n--------------------------------------------------\n";
+	list1.insert_after(list1.cbegin(),60);
+	std::cout << list1 << "\n";
+
+	std::cout << "\n--------------------------------------------------\n";
+	std::cout << "-------------Get current size ---=--------------------";
+	std::cout << "\n--------------------------------------------------\n";
+	std::cout << list1.size() << "\n";
+	
+	std::cout<<"\n--------------------------------------------------\n";
+	std::cout<<"----------------deleting at start-----------------";
+	std::cout<<"\n--------------------------------------------------\n";
+	list1.pop_front();
+	std::cout << list1 << "\n";
+	
+	std::cout<<"\n--------------------------------------------------\n";
+	std::cout<<"----------------deleting at end-----------------------";
+	std::cout<<"\n--------------------------------------------------\n";
+	list1.pop_back();
+	std::cout << list1 << "\n";
+	
+	
+	std::cout<<"\n----------------------------------------------------------\n";
+	std::cout<<"--------------Deleting after particular position--------------";
+	std::cout<<"\n-----------------------------------------------------------\n";
+	list1.erase_after(list1.cend());
+	std::cout << list1 << "\n";
+	
+	 list1.search(8) ? printf("yes"):printf("no");
+
+	 std::cout << "\n--------------------------------------------------\n";
+	 std::cout << "--------------Testing copy----------------------------";
+	 std::cout << "\n--------------------------------------------------\n";
+	 SingleLinkedList<int> list11 = list1;
+	 std::cout << list11 << "\n";
+
+	 ///////////////////////////////////////////////////////////////////////
+	 ///////////////////////////// Double Linked List //////////////////////
+	 ///////////////////////////////////////////////////////////////////////
+	 DoubleLinkedList<int> list2;
+	 list2.push_back(2);
+	 list2.push_back(4);
+	 list2.push_back(6);
+	 list2.push_back(8);
+	 list2.push_back(10);
+	 std::cout<<"\n--------------------------------------------------\n";
+	 std::cout<<"---------------displaying all nodes---------------";
+	 std::cout<<"\n--------------------------------------------------\n";
+	 std::cout << list2 << "\n";
+
+	 std::cout<<"\n--------------------------------------------------\n";
+	 std::cout<<"----------------Inserting At Start----------------";
+	 std::cout<<"\n--------------------------------------------------\n";
+	 list2.push_front(1);
+	 std::cout << list1 << "\n";
+
+	 std::cout << "\n--------------------------------------------------\n";
+	 std::cout << "-------------Get current size ---=--------------------";
+	 std::cout << "\n--------------------------------------------------\n";
+	 std::cout << list2.size() << "\n";
+
+	 std::cout<<"\n--------------------------------------------------\n";
+	 std::cout<<"----------------deleting at start-----------------";
+	 std::cout<<"\n--------------------------------------------------\n";
+	 list2.pop_front();
+	 std::cout << list2 << "\n";
+
+	 std::cout<<"\n--------------------------------------------------\n";
+	 std::cout<<"----------------deleting at end-----------------------";
+	 std::cout<<"\n--------------------------------------------------\n";
+	 list2.pop_back();
+	 std::cout << list1 << "\n";
+
+	 std::cout<<"\n--------------------------------------------------\n";
+	 std::cout<<"-------------inserting at particular--------------";
+	 std::cout<<"\n--------------------------------------------------\n";
+	 list2.insert(list2.cend(),60);
+	 std::cout << list1 << "\n";
+
+	 std::cout<<"\n----------------------------------------------------------\n";
+	 std::cout<<"--------------Deleting after particular position--------------";
+	 std::cout<<"\n-----------------------------------------------------------\n";
+	 list2.erase(list2.cend());
+	 std::cout << list1 << "\n";
+
+	  list2.search(8) ? printf("yes"):printf("no");
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Testing copy----------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  DoubleLinkedList<int> list22 = list2;
+	  std::cout << list22 << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Pooled nodes----------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  SingleLinkedList<int, PoolAllocator<int>> list3;
+	  DoubleLinkedList<int, PoolAllocator<int>> list4;
+	  for (int i = 0; i < 10; ++i) {
+		  list3.push_back(i);
+		  list4.push_front(i);
+	  }
+	  std::cout << list3 << "\n" << list4 << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Unrolled list---------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  UnrolledLinkedList<int, 4> list5;
+	  for (int i = 0; i < 10; ++i) {
+		  list5.push_back(i);
+	  }
+	  list5.insert_after(list5.cbegin(), 60);
+	  list5.erase_after(list5.cbegin());
+	  std::cout << list5 << "\n";
+	  list5.search(8) ? printf("yes") : printf("no");
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Concurrent list-------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  ConcurrentSingleLinkedList<int> list6;
+	  std::vector<std::thread> writers;
+	  for (int t = 0; t < 4; ++t) {
+		  writers.emplace_back([&list6, t] {
+			  for (int i = 0; i < 100; ++i) list6.push_front(t * 100 + i);
+			  for (int i = 0; i < 100; i += 2) list6.erase(t * 100 + i);
+		  });
+	  }
+	  for (auto& writer : writers) writer.join();
+	  std::cout << list6.size() << " elements left\n";
+	  list6.search(301) ? printf("yes") : printf("no");
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Sorting and merging---------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  SingleLinkedList<int> list7;
+	  DoubleLinkedList<int> list8;
+	  for (int i : { 7, 3, 9, 1, 5 }) {
+		  list7.push_back(i);
+		  list8.push_back(i + 1);
+	  }
+	  list7.sort();
+	  std::cout << list7 << "\n";
+	  list8.sort(std::greater<int>());
+	  std::cout << list8 << "\n";
+
+	  SingleLinkedList<int> list9;
+	  for (int i : { 2, 4, 6 }) list9.push_back(i);
+	  list7.merge(list9);
+	  std::cout << list7 << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Splicing--------------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  DoubleLinkedList<int> staging;
+	  for (int i = 20; i < 25; ++i) staging.push_back(i);
+	  list8.splice(list8.cbegin(), staging, staging.cbegin());
+	  list8.splice(list8.cend(), staging);
+	  std::cout << list8 << "\n";
+
+	  SingleLinkedList<int> list10;
+	  for (int i = 30; i < 35; ++i) list10.push_back(i);
+	  list7.splice_after(list7.cbefore_begin(), list10, list10.cbegin(), list10.cend());
+	  std::cout << list7 << "\n" << list10 << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Ranges----------------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::vector<int> values{ 1, 2, 3, 4 };
+	  SingleLinkedList<int> list13(values.begin(), values.end());
+	  DoubleLinkedList<int> list14{ 5, 6, 7 };
+	  list13.insert_range_after(list13.cbegin(), list14.begin(), list14.end());
+	  list14.assign(3, 0);
+	  list14.append_range(values.begin(), values.end());
+	  std::cout << list13 << "\n" << list14 << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Intrusive lists-------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::vector<Session> sessions(6);
+	  IntrusiveSingleLinkedList<Session, &Session::queue_hook> queue;
+	  IntrusiveDoubleLinkedList<Session, &Session::active_hook> active;
+	  for (int i = 0; i < 6; ++i) {
+		  sessions[i].id = i;
+		  queue.push_back(sessions[i]);
+		  active.push_front(sessions[i]);
+	  }
+	  active.erase(sessions[2]);
+	  queue.remove(sessions[4]);
+	  for (const Session& session : queue) std::cout << session.id << "\t";
+	  std::cout << "\n";
+	  for (const Session& session : active) std::cout << session.id << "\t";
+	  std::cout << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Teardown--------------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  DoubleLinkedList<int, PoolAllocator<int>> list15(1000000, 7);
+	  list15.clear_async();
+	  list15.push_back(1);
+	  std::cout << list15 << "\n";
+	  BackgroundReclaimer::drain();
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Linked queue----------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  LinkedQueue<int> work;
+	  std::thread io{ [&work] {
+		  std::vector<int> batch{ 1, 2, 3 };
+		  work.push_range(batch.begin(), batch.end());
+		  work.push(4);
+	  } };
+	  io.join();
+	  std::vector<int> done;
+	  work.pop_bulk(std::back_inserter(done));
+	  for (int x : done) std::cout << x << "\t";
+	  std::cout << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Ordered list----------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  OrderedLinkedList<int> levels{ 40, 10, 30 };
+	  levels.insert_sorted(20);
+	  levels.erase(30);
+	  std::cout << levels << "\n";
+	  std::cout << *levels.lower_bound(15) << "\t" << levels.search(30) << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Linked hash map--------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  LinkedHashMap<int, int, std::hash<int>, std::equal_to<int>, LinkOrder::Access> recent;
+	  recent.set_capacity(3);
+	  recent.set_eviction_callback([](std::pair<const int, int>& entry) { std::cout << "evicted " << entry.first << "\n"; });
+	  for (int page : { 1, 2, 3, 1, 4 }) recent[page] += 1;
+	  for (const auto& entry : recent) std::cout << entry.first << ":" << entry.second << "\t";
+	  std::cout << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Persistent list--------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  PersistentList<int> config{ 2, 3 };
+	  PersistentList<int> snapshot = config;
+	  config = config.push_front(1);
+	  std::cout << config << "\n" << snapshot << "\n";
+	  std::cout << std::boolalpha << (config.pop_front() == snapshot) << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Parallel algorithms----------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  DoubleLinkedList<int> samples;
+	  for (int i = 1; i <= 10000; ++i) samples.push_back(i);
+	  parallel::transform(samples, [](int x) { return x % 7; });
+	  std::cout << parallel::reduce(samples, 0) << "\t" << parallel::count_if(samples, [](int x) { return x == 0; }) << "\t";
+	  std::cout << std::distance(samples.begin(), parallel::find_if(samples, [](int x) { return x == 6; })) << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Serialization----------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::stringstream checkpoint;
+	  serialize(checkpoint, SingleLinkedList<std::string>{ "alpha", "beta", "gamma" });
+	  SingleLinkedList<std::string> restored;
+	  deserialize(checkpoint, restored);
+	  std::cout << restored << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Compact double linked list---------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  CompactDoubleLinkedList<int, true> packed{ 2, 3, 5 };
+	  packed.push_front(1);
+	  packed.insert(std::prev(packed.end()), 4);
+	  std::cout << packed << "\n";
+	  std::copy(packed.rbegin(), packed.rend(), std::ostream_iterator<int>(std::cout, "\t"));
+	  std::cout << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Index linked list-------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  IndexLinkedList<int> indexed{ 1, 2, 3, 4, 5 };
+	  indexed.erase(std::next(indexed.begin()));
+	  indexed.push_front(0);
+	  std::cout << indexed << "\t" << indexed.search(4) << "\t" << indexed.count(2) << "\n";
+	  indexed.compact();
+	  std::cout << indexed << "\t" << indexed.capacity() << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Relayout----------------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  SingleLinkedList<int, PoolAllocator<int>> drifted;
+	  for (int i = 0; i < 4096; ++i) drifted.push_back(i * 7919 % 4096);
+	  drifted.sort();
+	  std::cout << drifted.scattered_link_fraction() << "\t";
+	  for (auto at = drifted.relayout_after(drifted.cbefore_begin(), 1000); at != drifted.end(); at = drifted.relayout_after(at, 1000)) {}
+	  std::cout << drifted.scattered_link_fraction() << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Prefetching walk-------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  long walked = 0;
+	  drifted.for_each<8>([&walked](int x) { walked += x; });
+	  std::cout << walked << "\t" << drifted.search(4095) << "\n";
+
+	  std::cout << "\n--------------------------------------------------\n";
+	  std::cout << "--------------Multi-key search-------------------------";
+	  std::cout << "\n--------------------------------------------------\n";
+	  const std::vector<int> wanted{ 7, 4096, 0, 7 };
+	  for (bool hit : drifted.search_many(wanted.begin(), wanted.end())) std::cout << hit << "\t";
+	  std::cout << drifted.find_all([](int x) { return x % 1000 == 0; }).size() << "\n";
+
+	std::cin.get();
 }
\ No newline at end of file
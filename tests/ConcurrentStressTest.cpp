@@ -0,0 +1,155 @@
+//
+//  ConcurrentStressTest.cpp
+//  Data Structure - LinkedList
+//
+// Stress test for ConcurrentSingleLinkedList. Several threads push, erase and
+// search the same list at once; every element counts its own destruction, so
+// a node that is freed twice, or read after it was freed, shows up here even
+// without a sanitizer. Run it under the sanitize and tsan presets as well.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentSingleLinkedList.h"
+
+namespace {
+
+constexpr int thread_count = 4;
+constexpr int keys_per_thread = 4000;
+constexpr int key_count = thread_count * keys_per_thread;
+
+// Indexed by key, shared by every element with that key
+struct Ledger {
+	std::atomic<int> destroyed[key_count] = {};
+	std::atomic<int> erased[key_count] = {};
+	std::atomic<int> freed_twice{ 0 };
+	std::atomic<int> used_after_free{ 0 };
+};
+
+Ledger ledger;
+
+// Only the copy built inside a node is tracked, probes passed to search and
+// erase are not
+struct Tracked {
+	int key;
+	bool tracked;
+
+	explicit Tracked(int k, bool in_list = false) : key(k), tracked(in_list) {}
+	Tracked(const Tracked &) = delete;
+	Tracked& operator=(const Tracked &) = delete;
+	~Tracked() {
+		if (tracked && ledger.destroyed[key].fetch_add(1) != 0) ++ledger.freed_twice;
+	}
+
+	bool operator==(const Tracked &other) const {
+		if (tracked && ledger.destroyed[key].load() != 0) ++ledger.used_after_free;
+		if (other.tracked && ledger.destroyed[other.key].load() != 0) ++ledger.used_after_free;
+		return key == other.key;
+	}
+};
+
+// Keys owned by thread t are t * keys_per_thread + i. Odd keys are never
+// erased, even keys are erased by their owner and raced for by everyone else.
+void worker(ConcurrentSingleLinkedList<Tracked> &list, int t, std::atomic<int> &missing) {
+	std::mt19937 rng(t + 1);
+	const int first = t * keys_per_thread;
+
+	for (int i = 0; i < keys_per_thread; ++i) {
+		const int key = first + i;
+		list.emplace_front(key, true);
+		if (!list.search(Tracked(key))) ++missing;
+
+		// Steal an even key from anyone, it may not have been pushed yet
+		const int victim = int(rng() % key_count) & ~1;
+		if (list.erase(Tracked(victim))) ++ledger.erased[victim];
+
+		// Odd keys this thread already pushed must always be found
+		const int kept = (first + int(rng() % (i + 1))) | 1;
+		if (kept <= key && !list.search(Tracked(kept))) ++missing;
+
+		if (i % 2 == 1) {
+			const int mine = key - 1;
+			if (list.erase(Tracked(mine))) ++ledger.erased[mine];
+		}
+	}
+}
+
+}
+
+
+TEST(ConcurrentSingleLinkedList, PushEraseSearchStress) {
+	std::atomic<int> missing{ 0 };
+	std::atomic<bool> done{ false };
+	std::atomic<int> walked_freed{ 0 };
+
+	{
+		ConcurrentSingleLinkedList<Tracked> list;
+
+		// A reader walking the list the whole time must never see a freed element
+		std::thread reader([&] {
+			while (!done.load()) {
+				list.for_each([&](const Tracked &item) {
+					if (ledger.destroyed[item.key].load() != 0) ++walked_freed;
+				});
+			}
+		});
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < thread_count; ++t)
+			threads.emplace_back(worker, std::ref(list), t, std::ref(missing));
+		for (std::thread &thread : threads) thread.join();
+		done = true;
+		reader.join();
+
+		EXPECT_EQ(missing.load(), 0);
+		EXPECT_EQ(walked_freed.load(), 0);
+
+		// Every even key went exactly once, every odd key is still there
+		std::vector<int> present(key_count, 0);
+		list.for_each([&](const Tracked &item) { ++present[item.key]; });
+		for (int key = 0; key < key_count; ++key) {
+			if (key % 2 == 0) {
+				ASSERT_EQ(ledger.erased[key].load(), 1) << "key " << key;
+				ASSERT_EQ(present[key], 0) << "key " << key;
+				ASSERT_FALSE(list.search(Tracked(key))) << "key " << key;
+			} else {
+				ASSERT_EQ(ledger.erased[key].load(), 0) << "key " << key;
+				ASSERT_EQ(present[key], 1) << "key " << key;
+				ASSERT_EQ(ledger.destroyed[key].load(), 0) << "key " << key;
+			}
+		}
+		EXPECT_EQ(list.size(), std::size_t(key_count / 2));
+	}
+
+	// The list freed what it still held, erased nodes may still wait in an epoch bag
+	for (int key = 0; key < key_count; ++key) {
+		if (key % 2 == 1) ASSERT_EQ(ledger.destroyed[key].load(), 1) << "key " << key;
+		else ASSERT_LE(ledger.destroyed[key].load(), 1) << "key " << key;
+	}
+	EXPECT_EQ(ledger.freed_twice.load(), 0);
+	EXPECT_EQ(ledger.used_after_free.load(), 0);
+}
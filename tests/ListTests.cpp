@@ -0,0 +1,936 @@
+//
+//  ListTests.cpp
+//  Data Structure - LinkedList
+//
+// Functional checks for the list templates, built on GoogleTest. Every list
+// is compared against what a standard container, or a small model built on
+// one, holds after the same operations.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <gtest/gtest.h>
+#include "PoolAllocator.h"
+#include "SingleLinkedList.h"
+#include "DoubleLinkedList.h"
+#include "UnrolledLinkedList.h"
+#include "IndexLinkedList.h"
+#include "CompactDoubleLinkedList.h"
+#include "OrderedLinkedList.h"
+#include "LinkedHashMap.h"
+#include "PersistentList.h"
+#include "LinkedQueue.h"
+#include "IntrusiveSingleLinkedList.h"
+#include "IntrusiveDoubleLinkedList.h"
+#include "WorkStealingPool.h"
+#include "ParallelAlgorithms.h"
+#include "ListSerialization.h"
+
+namespace {
+
+// Throws from the copy constructor once the countdown runs out
+struct ThrowingCopy {
+	static int copies_left;
+	int value;
+
+	ThrowingCopy(int v) : value(v) {}
+	ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+		if (copies_left-- == 0) throw std::runtime_error("copy failed");
+	}
+	ThrowingCopy& operator=(const ThrowingCopy &) = default;
+	bool operator==(const ThrowingCopy &other) const { return value == other.value; }
+};
+int ThrowingCopy::copies_left = -1;
+
+// Keys for search_many without an operator<, one hashable and one not
+struct Hashed {
+	int value;
+	bool operator==(const Hashed &other) const { return value == other.value; }
+};
+
+struct Unordered {
+	int value;
+	bool operator==(const Unordered &other) const { return value == other.value; }
+};
+
+template <class List>
+auto contents(const List &list) {
+	return std::vector<std::decay_t<decltype(*list.begin())>>(list.begin(), list.end());
+}
+
+}
+
+namespace std {
+	template <>
+	struct hash<Hashed> {
+		std::size_t operator()(const Hashed &key) const noexcept { return std::hash<int>()(key.value); }
+	};
+}
+
+
+TEST(SingleLinkedList, PushPopAndSize) {
+	SingleLinkedList<int> list;
+	EXPECT_TRUE(list.empty());
+	list.push_back(2);
+	list.push_back(3);
+	list.push_front(1);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 1, 2, 3 }));
+	EXPECT_EQ(list.size(), 3u);
+
+	list.pop_back();
+	list.pop_front();
+	EXPECT_EQ(contents(list), (std::vector<int>{ 2 }));
+	list.pop_front();
+	list.pop_front();		// no-op on an empty list
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(list.size(), 0u);
+}
+
+TEST(SingleLinkedList, InsertAndEraseAfter) {
+	SingleLinkedList<int> list{ 1, 3 };
+	list.insert_after(list.cbegin(), 2);
+	list.insert_after(list.cbefore_begin(), 0);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 0, 1, 2, 3 }));
+
+	list.erase_after(list.cbegin());
+	list.erase_after(list.cbefore_begin());
+	EXPECT_EQ(contents(list), (std::vector<int>{ 2, 3 }));
+	list.push_back(4);		// tail has to follow the erases
+	EXPECT_EQ(contents(list), (std::vector<int>{ 2, 3, 4 }));
+}
+
+TEST(SingleLinkedList, BackLinksPopBack) {
+	SingleLinkedList<int, std::allocator<int>, true> list{ 1, 2, 3 };
+	list.pop_back();
+	list.pop_back();
+	list.push_back(5);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 1, 5 }));
+}
+
+TEST(SingleLinkedList, CopyMoveAndAssign) {
+	const SingleLinkedList<std::string> source{ "a", "b", "c" };
+	SingleLinkedList<std::string> copy{ source };
+	EXPECT_EQ(contents(copy), contents(source));
+
+	SingleLinkedList<std::string> moved{ std::move(copy) };
+	EXPECT_TRUE(copy.empty());
+	EXPECT_EQ(contents(moved), contents(source));
+
+	moved.assign(2, "x");
+	EXPECT_EQ(contents(moved), (std::vector<std::string>{ "x", "x" }));
+	moved.assign({ "p", "q", "r", "s" });
+	EXPECT_EQ(contents(moved), (std::vector<std::string>{ "p", "q", "r", "s" }));
+	moved.push_back("t");
+	EXPECT_EQ(moved.size(), 5u);
+}
+
+TEST(SingleLinkedList, BuildsFromProxyIterators) {
+	const std::vector<bool> bits{ true, false, true, true };
+	SingleLinkedList<bool> single(bits.begin(), bits.end());
+	DoubleLinkedList<bool> twice(bits.begin(), bits.end());
+	EXPECT_EQ(contents(single), (std::vector<bool>(bits.begin(), bits.end())));
+	EXPECT_EQ(contents(twice), (std::vector<bool>(bits.begin(), bits.end())));
+
+	std::istringstream words("x y z");
+	SingleLinkedList<std::string> read{ std::istream_iterator<std::string>(words), std::istream_iterator<std::string>() };
+	EXPECT_EQ(contents(read), (std::vector<std::string>{ "x", "y", "z" }));
+}
+
+TEST(SingleLinkedList, SortIsStableAndMergeKeepsOrder) {
+	SingleLinkedList<std::pair<int, int>> list;
+	std::list<std::pair<int, int>> expected;
+	std::mt19937 rng(1);
+	for (int i = 0; i < 500; ++i) {
+		const std::pair<int, int> item{ int(rng() % 20), i };
+		list.push_back(item);
+		expected.push_back(item);
+	}
+	auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+	list.sort(by_key);
+	expected.sort(by_key);
+	EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+	SingleLinkedList<int> a{ 1, 3, 5 }, b{ 2, 4, 6, 8 };
+	a.merge(b);
+	EXPECT_EQ(contents(a), (std::vector<int>{ 1, 2, 3, 4, 5, 6, 8 }));
+	EXPECT_TRUE(b.empty());
+	a.push_back(9);
+	EXPECT_EQ(a.size(), 8u);
+}
+
+TEST(SingleLinkedList, SpliceAfter) {
+	SingleLinkedList<int> a{ 1, 2 }, b{ 10, 11, 12 };
+	a.splice_after(a.cbegin(), b, b.cbegin());
+	EXPECT_EQ(contents(a), (std::vector<int>{ 1, 11, 2 }));
+	EXPECT_EQ(contents(b), (std::vector<int>{ 10, 12 }));
+
+	a.splice_after(a.cbefore_begin(), b);
+	EXPECT_EQ(contents(a), (std::vector<int>{ 10, 12, 1, 11, 2 }));
+	EXPECT_TRUE(b.empty());
+	EXPECT_EQ(a.size(), 5u);
+}
+
+TEST(SingleLinkedList, SearchManyAndFindAll) {
+	SingleLinkedList<int> list{ 5, 1, 4, 1, 3 };
+	const std::vector<int> keys{ 4, 7, 1, 4 };
+	EXPECT_EQ(list.search_many(keys.begin(), keys.end()), (std::vector<bool>{ true, false, true, true }));
+
+	const auto odd = list.find_all([](int x) { return x % 2 == 1; });
+	ASSERT_EQ(odd.size(), 4u);
+	EXPECT_EQ(*odd[0], 5);
+	EXPECT_EQ(*odd[3], 3);
+}
+
+TEST(SingleLinkedList, SearchManyMatchesSearch) {
+	// NaN never compares equal, so search() never finds it
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	DoubleLinkedList<double> numbers{ 1.5, nan, -0.0 };
+	const std::vector<double> probes{ nan, 0.0, 1.5, nan, 2.0, -0.0 };
+	std::vector<bool> expected;
+	for (double probe : probes) expected.push_back(numbers.search(probe));
+	EXPECT_EQ(numbers.search_many(probes.begin(), probes.end()), expected);
+
+	// Ordered by name only, equal only when the count matches too
+	struct Entry {
+		std::string name;
+		int count;
+		bool operator<(const Entry &other) const { return name < other.name; }
+		bool operator==(const Entry &other) const { return name == other.name && count == other.count; }
+	};
+	SingleLinkedList<Entry> entries{ { "a", 1 }, { "b", 2 }, { "a", 3 } };
+	const std::vector<Entry> keys{ { "a", 2 }, { "b", 2 }, { "a", 1 }, { "a", 3 }, { "a", 1 } };
+	EXPECT_EQ(entries.search_many(keys.begin(), keys.end()), (std::vector<bool>{ false, true, true, true, true }));
+
+	SingleLinkedList<std::string> words{ "pear", "fig", "plum" };
+	const std::vector<std::string> wanted{ "plum", "kiwi", "fig" };
+	EXPECT_EQ(words.search_many(wanted.begin(), wanted.end()), (std::vector<bool>{ true, false, true }));
+}
+
+TEST(SingleLinkedList, SearchManyWithoutOrdering) {
+	DoubleLinkedList<Hashed> hashed{ { 4 }, { 8 }, { 15 } };
+	const std::vector<Hashed> hashed_keys{ { 8 }, { 16 }, { 4 }, { 8 } };
+	EXPECT_EQ(hashed.search_many(hashed_keys.begin(), hashed_keys.end()), (std::vector<bool>{ true, false, true, true }));
+
+	SingleLinkedList<Unordered> plain{ { 1 }, { 2 } };
+	const std::vector<Unordered> plain_keys{ { 3 }, { 2 }, { 2 } };
+	EXPECT_EQ(plain.search_many(plain_keys.begin(), plain_keys.end()), (std::vector<bool>{ false, true, true }));
+}
+
+TEST(SingleLinkedList, RelayoutKeepsContents) {
+	SingleLinkedList<int, PoolAllocator<int>> list;
+	for (int i = 0; i < 5000; ++i) list.push_back(i * 7919 % 5000);
+	list.sort();
+	const std::vector<int> before = contents(list);
+	EXPECT_GT(list.scattered_link_fraction(), 0.5);
+
+	auto at = list.relayout_after(list.cbefore_begin(), 1000);
+	while (at != list.end()) at = list.relayout_after(at, 1000);
+	EXPECT_EQ(contents(list), before);
+	EXPECT_LT(list.scattered_link_fraction(), 0.1);
+	list.push_back(-1);
+	EXPECT_EQ(list.size(), before.size() + 1);
+}
+
+TEST(SingleLinkedList, RelayoutOfNothingKeepsPosition) {
+	SingleLinkedList<int> list{ 1, 2, 3, 4 };
+	auto middle = std::next(list.cbegin());
+	EXPECT_EQ(SingleLinkedList<int>::const_iterator(list.relayout_after(middle, 0)), middle);
+	EXPECT_EQ(list.relayout_after(list.cbefore_begin(), 0), list.before_begin());
+
+	auto at = list.relayout_after(middle, 1);
+	EXPECT_EQ(*at, 3);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 1, 2, 3, 4 }));
+}
+
+TEST(DoubleLinkedList, InsertEraseBothEnds) {
+	DoubleLinkedList<int> list{ 2, 4 };
+	list.insert(std::next(list.cbegin()), 3);
+	list.insert(list.cbegin(), 1);
+	list.insert(list.cend(), 5);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 1, 2, 3, 4, 5 }));
+
+	list.erase(std::next(list.cbegin(), 2));
+	list.pop_back();
+	list.pop_front();
+	EXPECT_EQ(contents(list), (std::vector<int>{ 2, 4 }));
+	EXPECT_EQ(*std::prev(list.end()), 4);
+
+	list.pop_front();
+	list.pop_front();
+	EXPECT_THROW(list.pop_front(), std::out_of_range);
+}
+
+TEST(DoubleLinkedList, SpliceAndRanges) {
+	DoubleLinkedList<int> a{ 1, 5 }, b{ 2, 3, 4 };
+	a.splice(std::next(a.cbegin()), b, b.cbegin(), b.cend());
+	EXPECT_EQ(contents(a), (std::vector<int>{ 1, 2, 3, 4, 5 }));
+	EXPECT_TRUE(b.empty());
+
+	const std::vector<int> more{ 6, 7 };
+	a.append_range(more.begin(), more.end());
+	a.insert_range(a.cbegin(), more.begin(), more.end());
+	EXPECT_EQ(contents(a), (std::vector<int>{ 6, 7, 1, 2, 3, 4, 5, 6, 7 }));
+	EXPECT_EQ(a.count(7), 2u);
+	EXPECT_TRUE(a.search(3));
+	EXPECT_FALSE(a.search(8));
+}
+
+TEST(DoubleLinkedList, PooledMatchesStdList) {
+	DoubleLinkedList<int, PoolAllocator<int>> list;
+	std::list<int> expected;
+	std::mt19937 rng(2);
+	for (int i = 0; i < 20000; ++i) {
+		const int value = int(rng() % 1000);
+		switch (rng() % 4) {
+		case 0: list.push_back(value); expected.push_back(value); break;
+		case 1: list.push_front(value); expected.push_front(value); break;
+		case 2: if (!expected.empty()) { list.pop_back(); expected.pop_back(); } break;
+		default: if (!expected.empty()) { list.pop_front(); expected.pop_front(); } break;
+		}
+	}
+	EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+	EXPECT_EQ(list.size(), expected.size());
+}
+
+TEST(UnrolledLinkedList, InsertEraseAndSearch) {
+	static_assert(std::is_same_v<UnrolledLinkedList<int, 4>::value_type, int>);
+	UnrolledLinkedList<int, 4> list;
+	for (int i = 0; i < 10; ++i) list.push_back(i);
+	list.insert_after(list.cbegin(), 60);
+	EXPECT_TRUE(list.search(60));
+	list.erase_after(list.cbegin());
+	EXPECT_FALSE(list.search(60));
+	EXPECT_EQ(contents(list), (std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+}
+
+TEST(IndexLinkedList, ReusesSlotsAndCompacts) {
+	IndexLinkedList<int> list{ 1, 2, 3, 4, 5 };
+	list.erase(std::next(list.begin()));
+	list.push_front(0);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 0, 1, 3, 4, 5 }));
+	EXPECT_FALSE(list.search(2));
+	EXPECT_EQ(list.count(3), 1u);
+
+	list.compact();
+	EXPECT_EQ(contents(list), (std::vector<int>{ 0, 1, 3, 4, 5 }));
+	EXPECT_EQ(std::vector<int>(list.rbegin(), list.rend()), (std::vector<int>{ 5, 4, 3, 1, 0 }));
+}
+
+TEST(IndexLinkedList, SearchesEveryLaneType) {
+	IndexLinkedList<long> longs;
+	IndexLinkedList<unsigned> unsigneds;
+	IndexLinkedList<float> floats;
+	for (int i = 0; i < 100; ++i) {
+		longs.push_back(-i * 3000000000L);
+		unsigneds.push_back(4000000000u - unsigned(i));
+		floats.push_back(i * 0.5f);
+	}
+	EXPECT_TRUE(longs.search(-99 * 3000000000L));
+	EXPECT_FALSE(longs.search(3000000000L));
+	EXPECT_EQ(unsigneds.count(4000000000u - 37u), 1u);
+	EXPECT_FALSE(unsigneds.search(1u));
+	EXPECT_TRUE(floats.search(49.5f));
+	EXPECT_FALSE(floats.search(0.25f));
+}
+
+TEST(IndexLinkedList, ThrowingCompactLeavesTheList) {
+	IndexLinkedList<ThrowingCopy> list;
+	for (int i = 0; i < 10; ++i) list.push_back(i);
+	list.erase(list.begin());
+	list.push_front(-1);
+
+	ThrowingCopy::copies_left = 5;
+	EXPECT_THROW(list.compact(), std::runtime_error);
+	ThrowingCopy::copies_left = -1;
+
+	std::vector<int> after;
+	for (const ThrowingCopy &item : list) after.push_back(item.value);
+	EXPECT_EQ(after, (std::vector<int>{ -1, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+	EXPECT_EQ(list.size(), 10u);
+}
+
+TEST(CompactDoubleLinkedList, OlderIteratorsStayValid) {
+	CompactDoubleLinkedList<int> list{ 1, 2, 3 };
+	const auto it = std::next(list.begin());
+	const auto it2 = std::next(list.begin());
+	list.insert(it2, 99);
+	list.erase(it);
+	EXPECT_EQ(contents(list), (std::vector<int>{ 1, 99, 3 }));
+
+	CompactDoubleLinkedList<int> tail{ 1, 2 };
+	const auto e = tail.end();
+	tail.push_back(3);
+	tail.insert(e, 4);
+	EXPECT_EQ(contents(tail), (std::vector<int>{ 1, 2, 3, 4 }));
+	EXPECT_EQ(*std::prev(e), 4);
+}
+
+// Keeps iterators to random elements across inserts and erases around them
+TEST(CompactDoubleLinkedList, MatchesStdListThroughHeldIterators) {
+	CompactDoubleLinkedList<int> list;
+	std::list<int> expected;
+	std::vector<std::pair<CompactDoubleLinkedList<int>::iterator, std::list<int>::iterator>> held;
+	std::mt19937 rng(3);
+	for (int i = 0; i < 20000; ++i) {
+		const int value = int(rng() % 1000);
+		const std::size_t pick = held.empty() ? 0 : rng() % held.size();
+		switch (rng() % 6) {
+		case 0: list.push_back(value); expected.push_back(value); break;
+		case 1: list.push_front(value); expected.push_front(value); break;
+		case 2:
+			if (held.empty()) held.emplace_back(list.insert(list.end(), value), expected.insert(expected.end(), value));
+			else held.emplace_back(list.insert(held[pick].first, value), expected.insert(held[pick].second, value));
+			break;
+		case 3:
+			if (!held.empty()) {
+				const auto victim = held[pick];
+				held.erase(std::remove_if(held.begin(), held.end(), [&](const auto &h) { return h.second == victim.second; }), held.end());
+				const auto next = list.erase(victim.first);
+				const auto expected_next = expected.erase(victim.second);
+				if (expected_next != expected.end()) {
+					ASSERT_EQ(*next, *expected_next);
+					held.emplace_back(next, expected_next);
+				}
+			}
+			break;
+		case 4:
+			if (!held.empty() && held[pick].second != expected.begin()) {
+				ASSERT_EQ(*std::prev(held[pick].first), *std::prev(held[pick].second));
+			}
+			break;
+		default:
+			if (!expected.empty()) {
+				const std::size_t at = rng() % expected.size();
+				held.emplace_back(std::next(list.begin(), std::ptrdiff_t(at)), std::next(expected.begin(), std::ptrdiff_t(at)));
+			}
+			break;
+		}
+		ASSERT_EQ(list.size(), expected.size());
+	}
+	EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+	EXPECT_TRUE(std::equal(list.rbegin(), list.rend(), expected.rbegin(), expected.rend()));
+}
+
+// XOR iterators are only good until a neighbour changes, so each one is made fresh
+TEST(CompactDoubleLinkedList, XorLinksMatchStdList) {
+	CompactDoubleLinkedList<int, true> list;
+	std::list<int> expected;
+	std::mt19937 rng(4);
+	for (int i = 0; i < 20000; ++i) {
+		const int value = int(rng() % 1000);
+		const std::ptrdiff_t at = expected.empty() ? 0 : std::ptrdiff_t(rng() % expected.size());
+		switch (rng() % 5) {
+		case 0: list.push_back(value); expected.push_back(value); break;
+		case 1: list.push_front(value); expected.push_front(value); break;
+		case 2: list.insert(std::next(list.begin(), at), value); expected.insert(std::next(expected.begin(), at), value); break;
+		case 3:
+			if (!expected.empty()) {
+				list.erase(std::next(list.begin(), at));
+				expected.erase(std::next(expected.begin(), at));
+			}
+			break;
+		default:
+			if (!expected.empty()) {
+				list.pop_back();
+				expected.pop_back();
+			}
+			break;
+		}
+		ASSERT_EQ(list.size(), expected.size());
+	}
+	EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+	EXPECT_TRUE(std::equal(list.rbegin(), list.rend(), expected.rbegin(), expected.rend()));
+}
+
+TEST(CompactDoubleLinkedList, ThrowingCopyFreesTheBlocks) {
+	CompactDoubleLinkedList<std::string> list;
+	for (int i = 0; i < 100; ++i) list.push_back(std::to_string(i));
+	CompactDoubleLinkedList<std::string> copy{ list };
+	EXPECT_EQ(contents(copy), contents(list));
+
+	// Under the sanitize preset a leak here fails the run
+	CompactDoubleLinkedList<ThrowingCopy, true> source;
+	for (int i = 0; i < 100; ++i) source.push_back(i);
+	ThrowingCopy::copies_left = 70;
+	EXPECT_THROW((CompactDoubleLinkedList<ThrowingCopy, true>{ source }), std::runtime_error);
+	ThrowingCopy::copies_left = 70;
+	EXPECT_THROW((CompactDoubleLinkedList<ThrowingCopy, true>(source.begin(), source.end())), std::runtime_error);
+	ThrowingCopy::copies_left = -1;
+}
+
+TEST(ListSerialization, RoundTrip) {
+	std::stringstream raw;
+	serialize(raw, SingleLinkedList<int>{ 1, 2, 3 });
+	DoubleLinkedList<int> numbers;
+	deserialize(raw, numbers);
+	EXPECT_EQ(contents(numbers), (std::vector<int>{ 1, 2, 3 }));
+
+	std::stringstream streamed;
+	serialize(streamed, SingleLinkedList<std::string>{ "alpha", "", "gamma" });
+	SingleLinkedList<std::string> words;
+	deserialize(streamed, words);
+	EXPECT_EQ(contents(words), (std::vector<std::string>{ "alpha", "", "gamma" }));
+}
+
+TEST(ListSerialization, CorruptStringLengthIsTruncation) {
+	std::stringstream raw;
+	serialize(raw, SingleLinkedList<std::string>{ "alpha", "beta" });
+	std::string bytes = raw.str();
+
+	// The first string claims to be far longer than the file
+	const std::uint64_t huge = ~std::uint64_t(0) / 2;
+	std::memcpy(&bytes[32], &huge, sizeof huge);
+
+	SingleLinkedList<std::string> words{ "kept" };
+	std::stringstream corrupt(bytes);
+	try {
+		deserialize(corrupt, words);
+		ADD_FAILURE() << "deserialize accepted a corrupt length";
+	}
+	catch (const std::runtime_error &e) {
+		EXPECT_STREQ(e.what(), "List file is truncated");
+	}
+	EXPECT_EQ(contents(words), (std::vector<std::string>{ "kept" }));
+
+	const std::string path = ::testing::TempDir() + "corrupt_strings.list";
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+	EXPECT_THROW(load_mapped(path.c_str(), words), std::runtime_error);
+	std::remove(path.c_str());
+	EXPECT_EQ(contents(words), (std::vector<std::string>{ "kept" }));
+}
+
+
+TEST(OrderedLinkedList, MatchesMultiset) {
+	OrderedLinkedList<int> list;
+	std::multiset<int> expected;
+	std::mt19937 rng(5);
+	for (int i = 0; i < 20000; ++i) {
+		const int value = int(rng() % 500);
+		switch (rng() % 4) {
+		case 0:
+		case 1: list.insert_sorted(value); expected.insert(value); break;
+		case 2: {
+			const auto it = expected.find(value);
+			ASSERT_EQ(list.erase(value), it != expected.end());
+			if (it != expected.end()) expected.erase(it);
+			break;
+		}
+		default:
+			ASSERT_EQ(list.count(value), expected.count(value));
+			ASSERT_EQ(list.lower_bound(value) == list.end(), expected.lower_bound(value) == expected.end());
+			ASSERT_EQ(list.upper_bound(value) == list.end(), expected.upper_bound(value) == expected.end());
+			if (list.lower_bound(value) != list.end()) {
+				ASSERT_EQ(*list.lower_bound(value), *expected.lower_bound(value));
+			}
+			if (list.upper_bound(value) != list.end()) {
+				ASSERT_EQ(*list.upper_bound(value), *expected.upper_bound(value));
+			}
+			break;
+		}
+		ASSERT_EQ(list.size(), expected.size());
+	}
+	EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+	OrderedLinkedList<int> copy{ list };
+	copy.pop_front();
+	expected.erase(expected.begin());
+	EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()));
+}
+
+TEST(OrderedLinkedList, EqualElementsKeepInsertionOrder) {
+	auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; };
+	OrderedLinkedList<std::pair<int, int>, decltype(by_key)> list(by_key);
+	std::vector<std::pair<int, int>> expected;
+	for (int i = 0; i < 1000; ++i) {
+		list.insert_sorted({ i % 10, i });
+		expected.push_back({ i % 10, i });
+	}
+	std::stable_sort(expected.begin(), expected.end(), by_key);
+	EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+}
+
+namespace {
+
+// What a LinkedHashMap should hold: the entries front to back, and where each key is
+template <LinkOrder Order>
+struct HashMapModel {
+	std::list<std::pair<int, int>> entries;
+	std::map<int, std::list<std::pair<int, int>>::iterator> where;
+	std::size_t capacity = 0;
+	std::vector<int> evicted;
+
+	void touch(int key) {
+		if (Order == LinkOrder::Access) entries.splice(entries.begin(), entries, where[key]);
+	}
+
+	void insert_or_assign(int key, int value) {
+		if (where.count(key)) {
+			where[key]->second = value;
+			touch(key);
+			return;
+		}
+		if (capacity != 0 && entries.size() >= capacity) {
+			evicted.push_back(entries.back().first);
+			where.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.push_front({ key, value });
+		where[key] = entries.begin();
+	}
+
+	bool find(int key) {
+		if (!where.count(key)) return false;
+		touch(key);
+		return true;
+	}
+
+	bool erase(int key) {
+		const auto it = where.find(key);
+		if (it == where.end()) return false;
+		entries.erase(it->second);
+		where.erase(it);
+		return true;
+	}
+};
+
+template <LinkOrder Order>
+void check_hash_map_against_model(unsigned seed, std::size_t capacity) {
+	LinkedHashMap<int, int, std::hash<int>, std::equal_to<int>, Order> map;
+	HashMapModel<Order> model;
+	std::vector<int> evicted;
+	if (capacity) {
+		map.set_capacity(capacity);
+		model.capacity = capacity;
+		map.set_eviction_callback([&evicted](std::pair<const int, int>& entry) { evicted.push_back(entry.first); });
+	}
+
+	std::mt19937 rng(seed);
+	for (int i = 0; i < 20000; ++i) {
+		const int key = int(rng() % 300);
+		switch (rng() % 4) {
+		case 0:
+		case 1: map.insert_or_assign(key, i); model.insert_or_assign(key, i); break;
+		case 2: ASSERT_EQ(map.find(key) != map.end(), model.find(key)); break;
+		default: ASSERT_EQ(map.erase(key), model.erase(key) ? 1u : 0u); break;
+		}
+		ASSERT_EQ(map.size(), model.entries.size());
+	}
+
+	std::vector<std::pair<int, int>> held;
+	for (const auto &entry : map) held.push_back({ entry.first, entry.second });
+	EXPECT_EQ(held, (std::vector<std::pair<int, int>>(model.entries.begin(), model.entries.end())));
+	EXPECT_EQ(evicted, model.evicted);
+	for (const auto &entry : model.entries) EXPECT_EQ(map.peek(entry.first)->second, entry.second);
+}
+
+}
+
+TEST(LinkedHashMap, InsertionOrderMatchesModel) {
+	check_hash_map_against_model<LinkOrder::Insertion>(6, 0);
+}
+
+TEST(LinkedHashMap, AccessOrderMatchesModel) {
+	check_hash_map_against_model<LinkOrder::Access>(7, 0);
+}
+
+TEST(LinkedHashMap, EvictsLeastRecentlyUsed) {
+	check_hash_map_against_model<LinkOrder::Access>(8, 64);
+	check_hash_map_against_model<LinkOrder::Insertion>(9, 64);
+
+	LinkedHashMap<int, std::string, std::hash<int>, std::equal_to<int>, LinkOrder::Access> cache;
+	cache.set_capacity(2);
+	cache[1] = "one";
+	cache[2] = "two";
+	cache.at(1);				// 2 is now the least recently used
+	cache[3] = "three";
+	EXPECT_FALSE(cache.contains(2));
+	EXPECT_EQ(cache.front().first, 3);
+	EXPECT_EQ(cache.back().first, 1);
+	EXPECT_THROW(cache.at(2), std::out_of_range);
+}
+
+TEST(PersistentList, EveryVersionKeepsItsContents) {
+	std::vector<PersistentList<int>> versions{ PersistentList<int>{} };
+	std::vector<std::vector<int>> expected{ {} };
+	std::mt19937 rng(10);
+	for (int i = 0; i < 5000; ++i) {
+		const std::size_t from = rng() % versions.size();
+		if (rng() % 3 != 0 || expected[from].empty()) {
+			versions.push_back(versions[from].push_front(i));
+			std::vector<int> next{ i };
+			next.insert(next.end(), expected[from].begin(), expected[from].end());
+			expected.push_back(std::move(next));
+		}
+		else {
+			versions.push_back(versions[from].pop_front());
+			expected.emplace_back(expected[from].begin() + 1, expected[from].end());
+		}
+		// Drop an old version now and then, the others must not notice
+		if (versions.size() > 200) {
+			const std::size_t gone = rng() % versions.size();
+			versions.erase(versions.begin() + std::ptrdiff_t(gone));
+			expected.erase(expected.begin() + std::ptrdiff_t(gone));
+		}
+	}
+	for (std::size_t v = 0; v < versions.size(); ++v) {
+		ASSERT_EQ(contents(versions[v]), expected[v]);
+		ASSERT_EQ(versions[v].size(), expected[v].size());
+		const PersistentList<int> reversed = versions[v].reverse();
+		ASSERT_TRUE(std::equal(reversed.begin(), reversed.end(), expected[v].rbegin(), expected[v].rend()));
+	}
+
+	const PersistentList<int> base{ 2, 3 };
+	const PersistentList<int> pushed = base.push_front(1);
+	EXPECT_TRUE(pushed.pop_front().shares_with(base));
+	EXPECT_TRUE(pushed.pop_front() == base);
+	EXPECT_TRUE(pushed.search(3));
+	EXPECT_FALSE(base.search(1));
+}
+
+TEST(LinkedQueue, SingleProducerIsFifo) {
+	LinkedQueue<std::string, QueueMode::SingleProducer> queue;
+	EXPECT_TRUE(queue.empty());
+	const std::vector<std::string> batch{ "b", "c", "d" };
+	queue.push("a");
+	queue.push_range(batch.begin(), batch.end());
+
+	std::string front;
+	ASSERT_TRUE(queue.try_pop(front));
+	EXPECT_EQ(front, "a");
+	std::vector<std::string> rest;
+	EXPECT_EQ(queue.pop_bulk(std::back_inserter(rest), 2), 2u);
+	EXPECT_EQ(queue.pop_bulk(std::back_inserter(rest)), 1u);
+	EXPECT_EQ(rest, batch);
+	EXPECT_FALSE(queue.try_pop(front));
+	EXPECT_TRUE(queue.empty());
+}
+
+// Each producer's items must come out in the order it pushed them, and all of them exactly once
+TEST(LinkedQueue, MultiProducerKeepsOrderAndSum) {
+	constexpr int producers = 4;
+	constexpr int per_producer = 50000;
+	LinkedQueue<std::pair<int, int>> queue;
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p) {
+		threads.emplace_back([&queue, p] {
+			for (int i = 0; i < per_producer; ) {
+				if (i % 3 == 0 && i + 4 <= per_producer) {
+					const std::pair<int, int> batch[] = { { p, i }, { p, i + 1 }, { p, i + 2 }, { p, i + 3 } };
+					queue.push_range(std::begin(batch), std::end(batch));
+					i += 4;
+				}
+				else {
+					queue.push({ p, i });
+					++i;
+				}
+			}
+		});
+	}
+
+	std::vector<int> next(producers, 0);
+	long long sum = 0;
+	int received = 0;
+	bool in_order = true;
+	std::vector<std::pair<int, int>> bulk;
+	while (received < producers * per_producer) {
+		bulk.clear();
+		std::pair<int, int> item;
+		if (received % 2 == 0) queue.pop_bulk(std::back_inserter(bulk), 100);
+		else if (queue.try_pop(item)) bulk.push_back(item);
+		for (const auto &popped : bulk) {
+			if (popped.second != next[popped.first]++) in_order = false;
+			sum += popped.second;
+			++received;
+		}
+		if (bulk.empty()) std::this_thread::yield();
+	}
+	for (std::thread &thread : threads) thread.join();
+
+	EXPECT_TRUE(in_order);
+	EXPECT_EQ(sum, (long long)producers * per_producer * (per_producer - 1) / 2);
+	EXPECT_TRUE(queue.empty());
+}
+
+namespace {
+
+struct Session {
+	int id;
+	SingleLinkHook<Session> hook;
+	DoubleLinkHook<Session> links;
+};
+
+template <class List>
+std::vector<int> ids(const List &list) {
+	std::vector<int> result;
+	for (const Session &session : list) result.push_back(session.id);
+	return result;
+}
+
+}
+
+TEST(IntrusiveSingleLinkedList, MatchesStdList) {
+	std::deque<Session> sessions;
+	for (int i = 0; i < 2000; ++i) sessions.push_back({ i, {}, {} });
+
+	IntrusiveSingleLinkedList<Session, &Session::hook> list;
+	std::list<int> expected;
+	std::vector<bool> linked(sessions.size(), false);
+	std::mt19937 rng(11);
+	int unused = 0;
+	for (int i = 0; i < 6000; ++i) {
+		const int pick = int(rng() % sessions.size());
+		switch (rng() % 5) {
+		case 0:
+			if (unused < int(sessions.size())) { list.push_back(sessions[unused]); expected.push_back(unused); linked[unused++] = true; }
+			break;
+		case 1:
+			if (unused < int(sessions.size())) { list.push_front(sessions[unused]); expected.push_front(unused); linked[unused++] = true; }
+			break;
+		case 2:
+			if (unused < int(sessions.size()) && linked[pick]) {
+				list.insert_after(list.iterator_to(sessions[pick]), sessions[unused]);
+				expected.insert(std::next(std::find(expected.begin(), expected.end(), pick)), unused);
+				linked[unused++] = true;
+			}
+			break;
+		case 3:
+			ASSERT_EQ(list.remove(sessions[pick]), bool(linked[pick]));
+			if (linked[pick]) expected.remove(pick);
+			linked[pick] = false;
+			break;
+		default:
+			if (!expected.empty()) {
+				linked[expected.front()] = false;
+				list.pop_front();
+				expected.pop_front();
+			}
+			break;
+		}
+		ASSERT_EQ(list.size(), expected.size());
+	}
+	EXPECT_EQ(ids(list), std::vector<int>(expected.begin(), expected.end()));
+	if (!expected.empty()) {
+		EXPECT_EQ(list.back().id, expected.back());
+	}
+	list.clear();
+	EXPECT_TRUE(list.empty());
+}
+
+TEST(IntrusiveDoubleLinkedList, MatchesStdList) {
+	std::deque<Session> sessions;
+	for (int i = 0; i < 2000; ++i) sessions.push_back({ i, {}, {} });
+
+	IntrusiveDoubleLinkedList<Session, &Session::links> list;
+	std::list<int> expected;
+	std::vector<bool> linked(sessions.size(), false);
+	std::mt19937 rng(12);
+	int unused = 0;
+	for (int i = 0; i < 6000; ++i) {
+		const int pick = int(rng() % sessions.size());
+		switch (rng() % 5) {
+		case 0:
+			if (unused < int(sessions.size())) { list.push_back(sessions[unused]); expected.push_back(unused); linked[unused++] = true; }
+			break;
+		case 1:
+			if (unused < int(sessions.size()) && linked[pick]) {
+				list.insert(list.iterator_to(sessions[pick]), sessions[unused]);
+				expected.insert(std::find(expected.begin(), expected.end(), pick), unused);
+				linked[unused++] = true;
+			}
+			break;
+		case 2:
+			if (linked[pick]) {
+				list.erase(sessions[pick]);
+				expected.remove(pick);
+				linked[pick] = false;
+			}
+			break;
+		case 3:
+			if (!expected.empty()) {
+				linked[expected.back()] = false;
+				list.pop_back();
+				expected.pop_back();
+			}
+			break;
+		default:
+			if (!expected.empty()) {
+				linked[expected.front()] = false;
+				list.pop_front();
+				expected.pop_front();
+			}
+			break;
+		}
+		ASSERT_EQ(list.size(), expected.size());
+	}
+	EXPECT_EQ(ids(list), std::vector<int>(expected.begin(), expected.end()));
+	std::vector<int> backwards;
+	for (auto it = list.rbegin(); it != list.rend(); ++it) backwards.push_back(it->id);
+	EXPECT_EQ(backwards, std::vector<int>(expected.rbegin(), expected.rend()));
+}
+
+TEST(ParallelAlgorithms, MatchSequentialResults) {
+	WorkStealingPool pool(3);
+	DoubleLinkedList<int> doubles;
+	SingleLinkedList<int> singles;
+	std::vector<int> expected;
+	for (int i = 0; i < 100000; ++i) {
+		doubles.push_back(i);
+		singles.push_back(i);
+		expected.push_back(i);
+	}
+
+	parallel::transform(doubles, [](int x) { return x % 97; }, pool);
+	std::transform(expected.begin(), expected.end(), expected.begin(), [](int x) { return x % 97; });
+	EXPECT_EQ(contents(doubles), expected);
+
+	std::atomic<long long> visited{ 0 };
+	parallel::for_each(singles, [&visited](int &x) { visited += x; x = -x; }, pool);
+	EXPECT_EQ(visited.load(), 100000LL * 99999 / 2);
+	EXPECT_EQ(*singles.begin(), 0);
+	EXPECT_EQ(*std::next(singles.begin(), 5), -5);
+
+	EXPECT_EQ(parallel::reduce(doubles, 0LL, std::plus<>(), pool), std::accumulate(expected.begin(), expected.end(), 0LL));
+	EXPECT_EQ(parallel::count_if(doubles, [](int x) { return x == 0; }, pool), std::size_t(std::count(expected.begin(), expected.end(), 0)));
+
+	// find_if returns the first match in list order, not whichever segment finishes first
+	const auto found = parallel::find_if(doubles, [](int x) { return x == 96; }, pool);
+	EXPECT_EQ(std::distance(doubles.begin(), found), std::distance(expected.begin(), std::find(expected.begin(), expected.end(), 96)));
+	EXPECT_EQ(parallel::find_if(doubles, [](int x) { return x > 1000; }, pool), doubles.end());
+
+	const auto part = make_partition(doubles, 8);
+	EXPECT_EQ(parallel::reduce(part, 0LL, std::plus<>(), pool), std::accumulate(expected.begin(), expected.end(), 0LL));
+}